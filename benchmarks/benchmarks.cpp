@@ -0,0 +1,291 @@
+#include "benchmarks.h"
+#include "legacyjsonwriter.h"
+#include "mainwindow.h"
+#include "map.h"
+#include "mapimageexporter.h"
+#include "mappixmapitem.h"
+#include "mapprefetcher.h"
+#include "project.h"
+#include "config.h"
+#include "log.h"
+#include "profiling.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGraphicsSceneMouseEvent>
+#include <QProgressDialog>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+
+using OrderedJson = poryjson::Json;
+using OrderedJsonDoc = poryjson::JsonDoc;
+
+// How often to check for a dialog waiting on the user, in milliseconds.
+static const int dialogCheckInterval = 100;
+
+// How many times each serializer stage writes the wild encounters JSON.
+static const int jsonWrites = 5;
+
+// Marks a project directory as generated by the benchmarks, so that it's safe to replace.
+static const QString generatedMarker = ".porymap-benchmark";
+
+Benchmarks::Benchmarks(const Options &options) : options(options) {
+    this->options.fills = qMax(0, this->options.fills);
+    this->options.jsonEncounters = qMax(0, this->options.jsonEncounters);
+}
+
+bool Benchmarks::run() {
+    this->stages.clear();
+    this->failure.clear();
+
+    QTemporaryDir tempDir;
+    QString dir = this->options.outputDir;
+    if (dir.isEmpty()) {
+        if (!tempDir.isValid()) {
+            logError("Could not create a temporary directory for the benchmark project: " + tempDir.errorString());
+            return false;
+        }
+        dir = tempDir.path();
+    }
+    tempDir.setAutoRemove(!this->options.keep);
+
+    // The project's directory name is its base game version, so that porymap doesn't ask for it.
+    const QString projectDir = QDir(dir).filePath("pokeemerald");
+    if (QDir(projectDir).exists()) {
+        if (!QFile::exists(QDir(projectDir).filePath(generatedMarker))) {
+            logError(QString("'%1' already exists and wasn't generated by the benchmarks").arg(projectDir));
+            return false;
+        }
+        QDir(projectDir).removeRecursively();
+    }
+    bool success = this->runProject(projectDir);
+    if (!this->options.keep && !this->options.outputDir.isEmpty())
+        QDir(projectDir).removeRecursively();
+    else if (this->options.keep)
+        logInfo(QString("Kept the benchmark project in '%1'").arg(projectDir));
+
+    success = this->runJsonStages() && success;
+
+    this->printReport();
+    if (!success)
+        logError("Benchmarks failed: " + this->failure);
+    return success;
+}
+
+bool Benchmarks::runProject(const QString &dir) {
+    ProjectGenerator generator(this->options.project);
+    if (!this->runStage("Generate project", [&generator, &dir] { return generator.generate(dir) ? generator.getNumFiles() : -1; }))
+        return false;
+    QFile marker(QDir(dir).filePath(generatedMarker));
+    marker.open(QIODevice::WriteOnly);
+    marker.close();
+
+    // Porymap shouldn't reopen the user's last project, or ask about files the benchmarks change.
+    porymapConfig.load();
+    porymapConfig.setReopenOnLaunch(false);
+    porymapConfig.setMonitorFiles(false);
+
+    MainWindow window(nullptr);
+    window.show();
+
+    // Nothing should wait on the user. If a dialog does (e.g. to report an error), it's closed and the benchmarks fail.
+    QTimer dialogCheck;
+    QObject::connect(&dialogCheck, &QTimer::timeout, [this] {
+        QWidget *dialog = QApplication::activeModalWidget();
+        if (!dialog || qobject_cast<QProgressDialog *>(dialog))
+            return;
+        this->failure = QString("Closed unexpected dialog '%1'").arg(dialog->windowTitle());
+        dialog->close();
+    });
+    dialogCheck.start(dialogCheckInterval);
+
+    const bool success = this->runStages(&window, dir);
+    dialogCheck.stop();
+    return success && this->failure.isEmpty();
+}
+
+bool Benchmarks::runStages(MainWindow *window, const QString &dir) {
+    if (!this->runStage("Project open", [window, &dir] { return window->openProject(dir) ? 1 : -1; }))
+        return false;
+
+    // Prefetching would load and render maps in between the stages.
+    window->mapPrefetcher->cancel();
+    Project *project = window->editor->project;
+    Map *editedMap = window->editor->map;
+    MapPixmapItem *mapItem = window->editor->map_item;
+    if (!editedMap || !mapItem) {
+        this->failure = "No map was opened";
+        return false;
+    }
+
+    bool success = this->runStage("Per-map load", [project] {
+        int numLoaded = 0;
+        for (const QString &mapName : project->mapNames) {
+            if (mapName == DYNAMIC_MAP_NAME || project->mapCache.contains(mapName))
+                continue;
+            if (!project->loadMap(mapName))
+                return -1;
+            numLoaded++;
+        }
+        return numLoaded;
+    });
+
+    success = success && this->runStage("Full render", [project] {
+        for (Map *map : project->mapCache) {
+            map->clearPrerenderedImages();
+            map->render(true);
+        }
+        return project->mapCache.size();
+    });
+
+    success = success && this->runStage("Collision render", [project] {
+        for (Map *map : project->mapCache)
+            map->renderCollision(true);
+        return project->mapCache.size();
+    });
+
+    // Each fill is ended the way releasing the mouse would, so that the fills are separate edits.
+    // They start from the top-left block, which the generator leaves in the map's largest area.
+    QGraphicsSceneMouseEvent releaseEvent(QEvent::GraphicsSceneMouseRelease);
+    success = success && this->runStage("Flood fill", [this, mapItem, &releaseEvent] {
+        for (int i = 0; i < this->options.fills; i++) {
+            mapItem->floodFill(0, 0, static_cast<uint16_t>((i % 2) ? 3 : 4));
+            mapItem->floodFill(&releaseEvent);
+        }
+        return this->options.fills;
+    });
+
+    success = success && this->runStage("Magic fill", [this, mapItem, &releaseEvent] {
+        for (int i = 0; i < this->options.fills; i++) {
+            mapItem->magicFill(0, 0, static_cast<uint16_t>((i % 2) ? 5 : 6));
+            mapItem->magicFill(&releaseEvent);
+        }
+        return this->options.fills;
+    });
+
+    success = success && this->runStage("Undo/redo", [editedMap] {
+        int numCommands = 0;
+        while (editedMap->editHistory.canUndo()) {
+            editedMap->editHistory.undo();
+            numCommands++;
+        }
+        while (editedMap->editHistory.canRedo()) {
+            editedMap->editHistory.redo();
+            numCommands++;
+        }
+        return numCommands;
+    });
+
+    // Every loaded map is changed, so that all of their files are written.
+    success = success && this->runStage("Save", [window, project] {
+        for (Map *map : project->mapCache) {
+            Block block;
+            if (map->getBlock(map->getWidth() - 1, map->getHeight() - 1, &block)) {
+                block.setMetatileId(block.metatileId() + 1);
+                map->setBlock(map->getWidth() - 1, map->getHeight() - 1, block);
+            }
+            map->hasUnsavedDataChanges = true;
+        }
+        const int numMaps = project->mapCache.size();
+        window->editor->saveProject();
+        return numMaps;
+    });
+
+    success = success && this->runStage("Stitch export", [window, &dir] {
+        MapImageExporter exporter(window, window->editor, ImageExporterMode::Stitch);
+        return exporter.writeImage(QDir(dir).filePath("stitch.png")) ? 1 : -1;
+    });
+
+    success = success && this->runStage("Timelapse export", [window, editedMap, &dir] {
+        const int numFrames = editedMap->editHistory.count() + 1;
+        MapImageExporter exporter(window, window->editor, ImageExporterMode::Timelapse);
+        return exporter.writeImage(QDir(dir).filePath("timelapse.gif")) ? numFrames : -1;
+    });
+
+    return success;
+}
+
+// Writes the same wild encounters JSON with the previous and current serializers, which should give identical output.
+bool Benchmarks::runJsonStages() {
+    QStringList mapConstants;
+    for (int i = 0; i < qMax(1, this->options.project.maps); i++)
+        mapConstants.append(Map::mapConstantFromName(ProjectGenerator::mapName(i)));
+    OrderedJson json = ProjectGenerator::buildWildEncounters(mapConstants, this->options.jsonEncounters, this->options.project.constants);
+    const qint64 size = OrderedJsonDoc(&json).toUtf8().size();
+
+    QByteArray legacyOutput;
+    bool success = this->runStage("JSON write (old)", [&json, &legacyOutput] {
+        for (int i = 0; i < jsonWrites; i++)
+            legacyOutput = LegacyJsonWriter::toUtf8(json);
+        return jsonWrites;
+    }, size * jsonWrites);
+
+    QByteArray output;
+    success = this->runStage("JSON write (new)", [&json, &output] {
+        for (int i = 0; i < jsonWrites; i++)
+            output = OrderedJsonDoc(&json).toUtf8();
+        return jsonWrites;
+    }, size * jsonWrites) && success;
+
+    if (output != legacyOutput) {
+        if (this->failure.isEmpty())
+            this->failure = "The old and new JSON writers gave different output";
+        return false;
+    }
+    return success;
+}
+
+// Runs and times one stage. The function returns the number of items it processed, or -1 if it failed.
+// If the stage reads or writes a known amount of data, its throughput is also reported.
+bool Benchmarks::runStage(const QString &name, std::function<int()> func, qint64 bytes) {
+    logInfo(QString("Running benchmark stage '%1'").arg(name));
+    PROFILE_SCOPE(QString("Benchmark: %1").arg(name));
+    QElapsedTimer timer;
+    timer.start();
+    const int items = func();
+
+    Stage stage;
+    stage.name = name;
+    stage.items = qMax(0, items);
+    stage.nsecs = timer.nsecsElapsed();
+    stage.bytes = bytes;
+    stage.peakMemory = Profiling::peakMemoryUsage();
+    this->stages.append(stage);
+
+    if (items < 0) {
+        this->failure = QString("Stage '%1' failed").arg(name);
+        return false;
+    }
+    return this->failure.isEmpty();
+}
+
+void Benchmarks::printReport() const {
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+           .arg("Stage", -20)
+           .arg("Items", 8)
+           .arg("Total (ms)", 12)
+           .arg("Mean (ms)", 12)
+           .arg("Items/s", 12)
+           .arg("MiB/s", 10)
+           .arg("Peak memory (MiB)", 18);
+    for (const Stage &stage : this->stages) {
+        const double totalMs = stage.nsecs / 1000000.0;
+        const double meanMs = stage.items ? totalMs / stage.items : 0.0;
+        const double itemsPerSecond = stage.nsecs ? stage.items * 1000000000.0 / stage.nsecs : 0.0;
+        const QString mebibytesPerSecond = (stage.bytes && stage.nsecs) ? QString::number(stage.bytes / (1024.0 * 1024.0) / (stage.nsecs / 1000000000.0), 'f', 1) : "-";
+        const QString peakMemory = stage.peakMemory >= 0 ? QString::number(stage.peakMemory / (1024.0 * 1024.0), 'f', 1) : "-";
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+               .arg(stage.name, -20)
+               .arg(stage.items, 8)
+               .arg(totalMs, 12, 'f', 2)
+               .arg(meanMs, 12, 'f', 3)
+               .arg(itemsPerSecond, 12, 'f', 1)
+               .arg(mebibytesPerSecond, 10)
+               .arg(peakMemory, 18);
+    }
+    out.flush();
+}
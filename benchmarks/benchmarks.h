@@ -0,0 +1,52 @@
+#pragma once
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "projectgenerator.h"
+
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class MainWindow;
+
+// Times porymap's slower operations on a generated project. The project is opened in a MainWindow,
+// and each stage goes through the same code as the user would (e.g. the fill tools and the image exporter).
+// The serializer stages compare writing a large wild encounters JSON with the current and previous OrderedJson writers.
+// The items, time, throughput and peak memory usage of each stage are printed when the benchmarks finish.
+class Benchmarks
+{
+public:
+    struct Options {
+        ProjectGenerator::Options project;
+        int fills = 50;
+        int jsonEncounters = 2000; // The size of the wild encounters JSON written by the serializer stages
+        QString outputDir; // A temporary directory is used if this is empty
+        bool keep = false;
+    };
+
+    explicit Benchmarks(const Options &options);
+
+    bool run();
+
+private:
+    struct Stage {
+        QString name;
+        int items = 0;
+        qint64 nsecs = 0;
+        qint64 bytes = 0;
+        qint64 peakMemory = -1;
+    };
+
+    Options options;
+    QVector<Stage> stages;
+    QString failure;
+
+    bool runStage(const QString &name, std::function<int()> func, qint64 bytes = 0);
+    bool runProject(const QString &dir);
+    bool runStages(MainWindow *window, const QString &dir);
+    bool runJsonStages();
+    void printReport() const;
+};
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Benchmarks for porymap's slower operations, run on a generated project.
+# Build and run with: qmake && make && ./porymap-benchmarks --help
+#
+#-------------------------------------------------
+
+TARGET = porymap-benchmarks
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../porymap.pri)
+
+INCLUDEPATH += $$PWD
+
+SOURCES += main.cpp \
+    benchmarks.cpp \
+    legacyjsonwriter.cpp \
+    projectgenerator.cpp
+
+HEADERS += benchmarks.h \
+    legacyjsonwriter.h \
+    projectgenerator.h
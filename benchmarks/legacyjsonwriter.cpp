@@ -0,0 +1,130 @@
+#include "legacyjsonwriter.h"
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+
+using poryjson::Json;
+
+static void dump(const Json &json, QString &out, int *indent);
+
+static void dumpString(const QString &value, QString &out, int *indent, bool isKey = false) {
+    if (!isKey && !out.endsWith(": ")) out += QString(*indent * 2, ' ');
+    out += '"';
+    for (int i = 0; i < value.length(); i++) {
+        const char ch = value[i].unicode();
+        if (ch == '\\') {
+            out += "\\\\";
+        } else if (ch == '"') {
+            out += "\\\"";
+        } else if (ch == '\b') {
+            out += "\\b";
+        } else if (ch == '\f') {
+            out += "\\f";
+        } else if (ch == '\n') {
+            out += "\\n";
+        } else if (ch == '\r') {
+            out += "\\r";
+        } else if (ch == '\t') {
+            out += "\\t";
+        } else if (static_cast<uint8_t>(ch) <= 0x1f) {
+            char buf[8];
+            snprintf(buf, sizeof buf, "\\u%04x", ch);
+            out += buf;
+        } else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(value[i+1].unicode()) == 0x80
+                   && static_cast<uint8_t>(value[i+2].unicode()) == 0xa8) {
+            out += "\\u2028";
+            i += 2;
+        } else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(value[i+1].unicode()) == 0x80
+                   && static_cast<uint8_t>(value[i+2].unicode()) == 0xa9) {
+            out += "\\u2029";
+            i += 2;
+        } else {
+            out += ch;
+        }
+    }
+    out += '"';
+}
+
+// Json doesn't say whether a number was an int or a double, so integral values are written the way ints were.
+static void dumpNumber(double value, QString &out, int *indent) {
+    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
+    char buf[32];
+    if (std::isfinite(value) && std::fabs(value) <= INT_MAX && value == static_cast<int>(value)) {
+        snprintf(buf, sizeof buf, "%d", static_cast<int>(value));
+        out += buf;
+    } else if (std::isfinite(value)) {
+        snprintf(buf, sizeof buf, "%.17g", value);
+        out += buf;
+    } else {
+        out += "null";
+    }
+}
+
+static void dumpArray(const Json::array &values, QString &out, int *indent) {
+    bool first = true;
+    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
+    out += "[\n";
+    *indent += 1;
+    for (const auto &value : values) {
+        if (!first) {
+            out += ",\n";
+        }
+        dump(value, out, indent);
+        first = false;
+    }
+    *indent -= 1;
+    out += "\n" + QString(*indent * 2, ' ') + "]";
+}
+
+static void dumpObject(const Json::object &values, QString &out, int *indent) {
+    bool first = true;
+    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
+    out += "{\n";
+    *indent += 1;
+    for (auto kv : values) {
+        if (!first) {
+            out += ",\n";
+        }
+        out += QString(*indent * 2, ' ');
+        dumpString(kv.first, out, indent, true);
+        out += ": ";
+        dump(kv.second, out, indent);
+        first = false;
+    }
+    *indent -= 1;
+    out += "\n" + QString(*indent * 2, ' ') + "}";
+}
+
+static void dump(const Json &json, QString &out, int *indent) {
+    switch (json.type()) {
+    case Json::NUL:
+        if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
+        out += "null";
+        break;
+    case Json::NUMBER:
+        dumpNumber(json.number_value(), out, indent);
+        break;
+    case Json::BOOL:
+        if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
+        out += json.bool_value() ? "true" : "false";
+        break;
+    case Json::STRING:
+        dumpString(json.string_value(), out, indent);
+        break;
+    case Json::ARRAY:
+        dumpArray(json.array_items(), out, indent);
+        break;
+    case Json::OBJECT:
+        dumpObject(json.object_items(), out, indent);
+        break;
+    }
+}
+
+QByteArray LegacyJsonWriter::toUtf8(const Json &json) {
+    int indent = 0;
+    QString out;
+    dump(json, out, &indent);
+    out += "\n"; // pad file with newline
+    return out.toUtf8();
+}
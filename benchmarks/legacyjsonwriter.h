@@ -0,0 +1,15 @@
+#pragma once
+#ifndef LEGACYJSONWRITER_H
+#define LEGACYJSONWRITER_H
+
+#include "orderedjson.h"
+
+#include <QByteArray>
+
+// The OrderedJson serializer from before JsonWriter, which built the document in a QString and then
+// converted it to UTF-8. It's kept here to compare against the current serializer.
+namespace LegacyJsonWriter {
+    QByteArray toUtf8(const poryjson::Json &json);
+}
+
+#endif // LEGACYJSONWRITER_H
@@ -0,0 +1,66 @@
+#include "benchmarks.h"
+#include "profiling.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QStandardPaths>
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    // The benchmarks don't need to show anything, unless a platform is chosen to watch them.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication a(argc, argv);
+    a.setStyle("fusion");
+
+    // Keep porymap's settings and log apart from the user's.
+    QCoreApplication::setOrganizationName("pret");
+    QCoreApplication::setApplicationName("porymap");
+    QStandardPaths::setTestModeEnabled(true);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times porymap's slower operations on a generated project.\n"
+                                     "Set PORYMAP_PROFILE to also log the time of each operation within the stages.");
+    parser.addHelpOption();
+    Benchmarks::Options options;
+    const QList<QPair<QCommandLineOption, int *>> countOptions = {
+        {QCommandLineOption("maps", "The number of maps.", "count", QString::number(options.project.maps)), &options.project.maps},
+        {QCommandLineOption("layouts", "The number of layouts (0 gives each map its own layout).", "count", QString::number(options.project.layouts)), &options.project.layouts},
+        {QCommandLineOption("tilesets", "The number of primary tilesets, and of secondary tilesets.", "count", QString::number(options.project.tilesets)), &options.project.tilesets},
+        {QCommandLineOption("events", "The number of events in each map.", "count", QString::number(options.project.eventsPerMap)), &options.project.eventsPerMap},
+        {QCommandLineOption("constants", "The number of constants of each kind (flags, vars, items, species, etc.).", "count", QString::number(options.project.constants)), &options.project.constants},
+        {QCommandLineOption("scripts", "The number of scripts in each map.", "count", QString::number(options.project.scriptsPerMap)), &options.project.scriptsPerMap},
+        {QCommandLineOption("encounters", "The number of wild encounter groups.", "count", QString::number(options.project.encounters)), &options.project.encounters},
+        {QCommandLineOption("width", "The width of each map, in metatiles.", "width", QString::number(options.project.mapWidth)), &options.project.mapWidth},
+        {QCommandLineOption("height", "The height of each map, in metatiles.", "height", QString::number(options.project.mapHeight)), &options.project.mapHeight},
+        {QCommandLineOption("fills", "The number of flood fills, and of magic fills.", "count", QString::number(options.fills)), &options.fills},
+        {QCommandLineOption("json-encounters", "The number of wild encounter groups in the JSON written by the serializer stages.", "count", QString::number(options.jsonEncounters)), &options.jsonEncounters},
+    };
+    for (const auto &option : countOptions)
+        parser.addOption(option.first);
+    const QCommandLineOption outputOption("output", "The directory to generate the project in (a temporary directory by default).", "dir");
+    const QCommandLineOption keepOption("keep", "Keep the generated project after the benchmarks finish.");
+    parser.addOption(outputOption);
+    parser.addOption(keepOption);
+    parser.process(a);
+
+    for (const auto &option : countOptions) {
+        bool ok;
+        const QString value = parser.value(option.first);
+        *option.second = value.toInt(&ok);
+        if (!ok || *option.second < 0) {
+            fprintf(stderr, "Invalid value '%s' for --%s\n", qPrintable(value), qPrintable(option.first.names().first()));
+            return 1;
+        }
+    }
+    options.outputDir = parser.value(outputOption);
+    options.keep = parser.isSet(keepOption);
+
+    Profiling::init();
+    Benchmarks benchmarks(options);
+    const bool success = benchmarks.run();
+    Profiling::finish();
+    return success ? 0 : 1;
+}
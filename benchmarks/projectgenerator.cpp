@@ -0,0 +1,581 @@
+#include "projectgenerator.h"
+#include "map.h"
+#include "tileset.h"
+#include "paletteutil.h"
+#include "log.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QRegularExpression>
+
+using OrderedJson = poryjson::Json;
+using OrderedJsonDoc = poryjson::JsonDoc;
+
+// The tileset limits of pokeemerald, which are also written to include/fieldmap.h.
+static const int numTilesPerTileset = 512;
+static const int numMetatilesPerTileset = 512;
+static const int numPalsPrimary = 6;
+static const int numPalsTotal = 13;
+
+// Each cluster of connected maps is laid out in a grid this many maps wide and tall.
+static const int clusterWidth = 3;
+static const int clusterSize = clusterWidth * clusterWidth;
+
+// Most of each map is this metatile, so that flood fills cover a large area.
+static const uint16_t baseMetatileId = 1;
+
+static QString numberedName(const QString &prefix, int index) {
+    return QString("%1%2").arg(prefix).arg(index, 4, 10, QChar('0'));
+}
+
+static QStringList numberedNames(const QString &prefix, int count) {
+    QStringList names;
+    for (int i = 0; i < count; i++)
+        names.append(numberedName(prefix, i));
+    return names;
+}
+
+static QByteArray defines(const QStringList &names, int firstValue = 0) {
+    QString text;
+    for (int i = 0; i < names.length(); i++)
+        text += QString("#define %1 %2\n").arg(names.at(i)).arg(firstValue + i);
+    return text.toUtf8();
+}
+
+static void appendU16(QByteArray *data, uint16_t value) {
+    data->append(static_cast<char>(value & 0xFF));
+    data->append(static_cast<char>(value >> 8));
+}
+
+static uint16_t blockValue(uint16_t metatileId, uint16_t collision, uint16_t elevation) {
+    return metatileId | (collision << 10) | (elevation << 12);
+}
+
+static QString tilesetFriendlyName(const QString &tilesetName) {
+    return QString(tilesetName).remove("gTileset_");
+}
+
+ProjectGenerator::ProjectGenerator(const Options &options) : options(options) {
+    this->options.maps = qMax(1, this->options.maps);
+    this->options.layouts = this->options.layouts > 0 ? this->options.layouts : this->options.maps;
+    this->options.tilesets = qMax(1, this->options.tilesets);
+    this->options.eventsPerMap = qMax(0, this->options.eventsPerMap);
+    this->options.constants = qMax(1, this->options.constants);
+    this->options.scriptsPerMap = qMax(1, this->options.scriptsPerMap);
+    this->options.encounters = qMax(0, this->options.encounters);
+    this->options.mapWidth = qMax(1, this->options.mapWidth);
+    this->options.mapHeight = qMax(1, this->options.mapHeight);
+}
+
+QString ProjectGenerator::mapName(int index) {
+    return numberedName("BenchMap", index);
+}
+
+QString ProjectGenerator::speciesName(int index) {
+    return numberedName("SPECIES_BENCH_", index);
+}
+
+bool ProjectGenerator::generate(const QString &root) {
+    this->root = root;
+    this->numFiles = 0;
+    this->numBytes = 0;
+    this->failed = false;
+
+    this->mapNames.clear();
+    this->mapConstants.clear();
+    for (int i = 0; i < this->options.maps; i++) {
+        this->mapNames.append(mapName(i));
+        this->mapConstants.append(Map::mapConstantFromName(this->mapNames.last()));
+    }
+    this->layoutNames = numberedNames("BenchLayout", this->options.layouts);
+    this->primaryTilesets.clear();
+    this->secondaryTilesets.clear();
+    for (int i = 0; i < this->options.tilesets; i++) {
+        this->primaryTilesets.append(QString("gTileset_BenchPrimary%1").arg(i));
+        this->secondaryTilesets.append(QString("gTileset_BenchSecondary%1").arg(i));
+    }
+
+    this->writeConstants();
+    this->writeTilesets();
+    this->writeLayouts();
+    this->writeMaps();
+    this->writeScripts();
+    this->writeWildEncounters();
+    this->writeMiscellaneous();
+    return !this->failed;
+}
+
+void ProjectGenerator::writeFile(const QString &path, const QByteArray &data) {
+    const QString filepath = QDir(this->root).filePath(path);
+    QDir().mkpath(QFileInfo(filepath).absolutePath());
+    QFile file(filepath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+        logError(QString("Could not write '%1': ").arg(filepath) + file.errorString());
+        this->failed = true;
+        return;
+    }
+    this->numFiles++;
+    this->numBytes += data.size();
+}
+
+void ProjectGenerator::writeConstants() {
+    const int count = this->options.constants;
+    this->writeFile("include/constants/flags.h", defines(numberedNames("FLAG_BENCH_", count), 1));
+    this->writeFile("include/constants/vars.h", defines(numberedNames("VAR_BENCH_", count), 0x4000));
+    this->writeFile("include/constants/items.h", defines(QStringList{"ITEM_NONE"} + numberedNames("ITEM_BENCH_", count)));
+    this->writeFile("include/constants/songs.h", defines(numberedNames("MUS_BENCH_", count), 350));
+    this->writeFile("include/constants/species.h", defines(QStringList{"SPECIES_NONE"} + numberedNames("SPECIES_BENCH_", count)));
+    this->writeFile("include/constants/event_objects.h", defines(numberedNames("OBJ_EVENT_GFX_BENCH_", qMin(count, 239))));
+    this->writeFile("include/constants/secret_bases.h", defines(numberedNames("SECRET_BASE_BENCH_", qMin(count, 64)), 1));
+    this->writeFile("include/constants/metatile_behaviors.h", defines(QStringList{"MB_NORMAL"} + numberedNames("MB_BENCH_", qMin(count, 239))));
+    this->writeFile("include/constants/region_map_sections.h", defines(numberedNames("MAPSEC_BENCH_", qMin(count, 200)) + QStringList{"MAPSEC_NONE"}));
+
+    this->writeFile("include/constants/map_types.h", defines({
+        "MAP_TYPE_NONE", "MAP_TYPE_TOWN", "MAP_TYPE_CITY", "MAP_TYPE_ROUTE", "MAP_TYPE_UNDERGROUND",
+        "MAP_TYPE_UNDERWATER", "MAP_TYPE_OCEAN_ROUTE", "MAP_TYPE_UNKNOWN", "MAP_TYPE_INDOOR", "MAP_TYPE_SECRET_BASE",
+    }) + defines({
+        "MAP_BATTLE_SCENE_NORMAL", "MAP_BATTLE_SCENE_GYM", "MAP_BATTLE_SCENE_MAGMA", "MAP_BATTLE_SCENE_AQUA",
+    }));
+    this->writeFile("include/constants/weather.h", defines({
+        "WEATHER_NONE", "WEATHER_SUNNY_CLOUDS", "WEATHER_SUNNY", "WEATHER_RAIN", "WEATHER_SNOW", "WEATHER_FOG_HORIZONTAL",
+    }) + defines({
+        "COORD_EVENT_WEATHER_SUNNY_CLOUDS", "COORD_EVENT_WEATHER_SUNNY", "COORD_EVENT_WEATHER_RAIN",
+    }, 1));
+    this->writeFile("include/constants/trainer_types.h", defines({
+        "TRAINER_TYPE_NONE", "TRAINER_TYPE_NORMAL", "TRAINER_TYPE_SEE_ALL_DIRECTIONS", "TRAINER_TYPE_BURIED",
+    }));
+    this->writeFile("include/constants/event_object_movement.h", defines({
+        "MOVEMENT_TYPE_NONE", "MOVEMENT_TYPE_LOOK_AROUND", "MOVEMENT_TYPE_WANDER_AROUND", "MOVEMENT_TYPE_FACE_UP",
+        "MOVEMENT_TYPE_FACE_DOWN", "MOVEMENT_TYPE_FACE_LEFT", "MOVEMENT_TYPE_FACE_RIGHT",
+    }));
+    this->writeFile("include/constants/event_bg.h", defines({
+        "BG_EVENT_PLAYER_FACING_ANY", "BG_EVENT_PLAYER_FACING_NORTH", "BG_EVENT_PLAYER_FACING_SOUTH",
+        "BG_EVENT_PLAYER_FACING_EAST", "BG_EVENT_PLAYER_FACING_WEST",
+    }));
+    this->writeFile("include/constants/pokemon.h", "#define MIN_LEVEL 1\n#define MAX_LEVEL 100\n");
+    this->writeFile("include/constants/global.h", "#define OBJECT_EVENT_TEMPLATES_COUNT 64\n");
+
+    // Each tileset has a few labelled metatiles.
+    QString metatileLabels;
+    for (int i = 0; i < this->options.tilesets; i++) {
+        for (int j = 0; j < qMin(count, 32); j++) {
+            metatileLabels += QString("#define METATILE_%1_Bench%2 0x%3\n")
+                    .arg(tilesetFriendlyName(this->primaryTilesets.at(i))).arg(j).arg(j, 3, 16, QChar('0'));
+            metatileLabels += QString("#define METATILE_%1_Bench%2 0x%3\n")
+                    .arg(tilesetFriendlyName(this->secondaryTilesets.at(i))).arg(j).arg(numMetatilesPerTileset + j, 3, 16, QChar('0'));
+        }
+    }
+    this->writeFile("include/constants/metatile_labels.h", metatileLabels.toUtf8());
+
+    // The map data must fit the largest map, including the area around it that the game loads.
+    const int maxMapDataSize = qMax(10240, (this->options.mapWidth + 15) * (this->options.mapHeight + 14));
+    this->writeFile("include/fieldmap.h", QString(
+        "#define NUM_TILES_IN_PRIMARY %1\n"
+        "#define NUM_TILES_TOTAL %2\n"
+        "#define NUM_METATILES_IN_PRIMARY %3\n"
+        "#define NUM_METATILES_TOTAL %4\n"
+        "#define NUM_PALS_IN_PRIMARY %5\n"
+        "#define NUM_PALS_TOTAL %6\n"
+        "#define MAX_MAP_DATA_SIZE %7\n")
+        .arg(numTilesPerTileset).arg(numTilesPerTileset * 2)
+        .arg(numMetatilesPerTileset).arg(numMetatilesPerTileset * 2)
+        .arg(numPalsPrimary).arg(numPalsTotal)
+        .arg(maxMapDataSize).toUtf8());
+    this->writeFile("include/global.fieldmap.h",
+        "#define MAPGRID_METATILE_ID_MASK 0x03FF\n"
+        "#define MAPGRID_COLLISION_MASK 0x0C00\n"
+        "#define MAPGRID_ELEVATION_MASK 0xF000\n"
+        "#define METATILE_ATTR_BEHAVIOR_MASK 0x00FF\n"
+        "#define METATILE_ATTR_LAYER_MASK 0xF000\n");
+}
+
+void ProjectGenerator::writeTilesets() {
+    QString headers;
+    QString graphics;
+    QString metatiles;
+    for (int i = 0; i < this->options.tilesets * 2; i++) {
+        const bool isSecondary = i >= this->options.tilesets;
+        const QString name = isSecondary ? this->secondaryTilesets.at(i - this->options.tilesets) : this->primaryTilesets.at(i);
+        const QString friendlyName = tilesetFriendlyName(name);
+        const QString dir = Tileset::getExpectedDir(name, isSecondary);
+
+        headers += QString("const struct Tileset %1 =\n{\n"
+                           "    .isCompressed = TRUE,\n"
+                           "    .isSecondary = %2,\n"
+                           "    .tiles = gTilesetTiles_%3,\n"
+                           "    .palettes = gTilesetPalettes_%3,\n"
+                           "    .metatiles = gMetatiles_%3,\n"
+                           "    .metatileAttributes = gMetatileAttributes_%3,\n"
+                           "    .callback = NULL,\n"
+                           "};\n\n").arg(name).arg(isSecondary ? "TRUE" : "FALSE").arg(friendlyName);
+
+        graphics += QString("const u32 gTilesetTiles_%1[] = INCBIN_U32(\"%2/tiles.4bpp.lz\");\n\n").arg(friendlyName).arg(dir);
+        graphics += QString("const u16 gTilesetPalettes_%1[][16] =\n{\n").arg(friendlyName);
+        for (int j = 0; j < 16; j++)
+            graphics += QString("    INCBIN_U16(\"%1/palettes/%2.gbapal\"),\n").arg(dir).arg(j, 2, 10, QChar('0'));
+        graphics += "};\n\n";
+
+        metatiles += QString("const u16 gMetatiles_%1[] = INCBIN_U16(\"%2/metatiles.bin\");\n").arg(friendlyName).arg(dir);
+        metatiles += QString("const u16 gMetatileAttributes_%1[] = INCBIN_U16(\"%2/metatile_attributes.bin\");\n\n").arg(friendlyName).arg(dir);
+
+        this->writeTileset(dir, isSecondary, i);
+    }
+    this->writeFile("src/data/tilesets/headers.h", headers.toUtf8());
+    this->writeFile("src/data/tilesets/graphics.h", graphics.toUtf8());
+    this->writeFile("src/data/tilesets/metatiles.h", metatiles.toUtf8());
+}
+
+void ProjectGenerator::writeTileset(const QString &dir, bool isSecondary, int index) {
+    // The tiles are a 4bpp image, 16 tiles wide. They're patterned so that each tile is drawn differently.
+    QVector<QRgb> colorTable;
+    for (int i = 0; i < 16; i++)
+        colorTable.append(qRgb(i * 16, i * 16, i * 16));
+    QImage image(16 * 8, numTilesPerTileset / 16 * 8, QImage::Format_Indexed8);
+    image.setColorTable(colorTable);
+    for (int y = 0; y < image.height(); y++) {
+        for (int x = 0; x < image.width(); x++)
+            image.setPixel(x, y, (x * 3 + y * 5 + (x / 8) * (y / 8) + index) % 16);
+    }
+    QByteArray imageData;
+    QBuffer buffer(&imageData);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    this->writeFile(dir + "/tiles.png", imageData);
+
+    for (int i = 0; i < 16; i++) {
+        QVector<QRgb> colors;
+        for (int j = 0; j < 16; j++)
+            colors.append(qRgb((j * 16 + i * 8 + index * 40) & 0xF8, (j * 8 + i * 16) & 0xF8, (255 - j * 16) & 0xF8));
+        this->writeFile(QString("%1/palettes/%2.pal").arg(dir).arg(i, 2, 10, QChar('0')), PaletteUtil::serializeJASC(colors, 0, 16));
+    }
+
+    // Each metatile has 8 tiles, each with a tile id, flips and a palette id that are valid for the tileset.
+    QByteArray metatiles;
+    QByteArray attributes;
+    const int firstTile = isSecondary ? numTilesPerTileset : 0;
+    for (int i = 0; i < numMetatilesPerTileset; i++) {
+        for (int j = 0; j < 8; j++) {
+            const int tileId = firstTile + (i * 8 + j) % numTilesPerTileset;
+            const int flips = (i + j) % 4;
+            const int paletteId = isSecondary ? numPalsPrimary + i % (numPalsTotal - numPalsPrimary) : i % numPalsPrimary;
+            appendU16(&metatiles, tileId | (flips << 10) | (paletteId << 12));
+        }
+        const int numBehaviors = 1 + qMin(this->options.constants, 239);
+        appendU16(&attributes, (i % numBehaviors) | ((i % 3) << 12));
+    }
+    this->writeFile(dir + "/metatiles.bin", metatiles);
+    this->writeFile(dir + "/metatile_attributes.bin", attributes);
+}
+
+void ProjectGenerator::writeLayouts() {
+    const int width = this->options.mapWidth;
+    const int height = this->options.mapHeight;
+
+    OrderedJson::array layoutsArr;
+    for (int i = 0; i < this->layoutNames.length(); i++) {
+        const QString name = this->layoutNames.at(i);
+        const QString dir = QString("data/layouts/%1").arg(name);
+
+        OrderedJson::object layoutObj;
+        layoutObj["id"] = numberedName("LAYOUT_BENCH_LAYOUT", i);
+        layoutObj["name"] = name;
+        layoutObj["width"] = width;
+        layoutObj["height"] = height;
+        layoutObj["primary_tileset"] = this->primaryTilesets.at(i % this->options.tilesets);
+        layoutObj["secondary_tileset"] = this->secondaryTilesets.at(i % this->options.tilesets);
+        layoutObj["border_filepath"] = dir + "/border.bin";
+        layoutObj["blockdata_filepath"] = dir + "/map.bin";
+        layoutsArr.push_back(layoutObj);
+
+        QByteArray border;
+        for (int j = 0; j < 4; j++)
+            appendU16(&border, blockValue(baseMetatileId + j, 0, 0));
+        this->writeFile(dir + "/border.bin", border);
+
+        // Most of the map is the base metatile, with other metatiles from both tilesets scattered
+        // through it. The scattered metatiles never touch, so the base metatile is one connected area.
+        QByteArray blockdata;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if ((x * 31 + y * 17) % 11 == 5) {
+                    const uint16_t metatileId = 2 + (x + y + i) % 200 + (y % 2 ? numMetatilesPerTileset : 0);
+                    appendU16(&blockdata, blockValue(metatileId, 1, 3));
+                } else {
+                    appendU16(&blockdata, blockValue(baseMetatileId, 0, 3));
+                }
+            }
+        }
+        this->writeFile(dir + "/map.bin", blockdata);
+    }
+
+    OrderedJson::object layoutsObj;
+    layoutsObj["layouts_table_label"] = "gMapLayouts";
+    layoutsObj["layouts"] = layoutsArr;
+    OrderedJson layoutsJson(layoutsObj);
+    this->writeFile("data/layouts/layouts.json", OrderedJsonDoc(&layoutsJson).toUtf8());
+}
+
+void ProjectGenerator::writeMaps() {
+    OrderedJson::object mapGroupsObj;
+    OrderedJson::array groupOrder;
+    for (int i = 0; i < this->options.maps; i += clusterSize) {
+        const QString groupName = numberedName("gMapGroup_Bench", i / clusterSize);
+        OrderedJson::array groupArr;
+        for (int j = i; j < qMin(i + clusterSize, this->options.maps); j++)
+            groupArr.push_back(this->mapNames.at(j));
+        groupOrder.push_back(groupName);
+        mapGroupsObj[groupName] = groupArr;
+    }
+    mapGroupsObj["group_order"] = groupOrder;
+    OrderedJson mapGroupsJson(mapGroupsObj);
+    this->writeFile("data/maps/map_groups.json", OrderedJsonDoc(&mapGroupsJson).toUtf8());
+
+    for (int i = 0; i < this->options.maps; i++)
+        this->writeMap(i);
+}
+
+void ProjectGenerator::writeMap(int index) {
+    const QString name = this->mapNames.at(index);
+    const int count = this->options.constants;
+    const int width = this->options.mapWidth;
+    const int height = this->options.mapHeight;
+    const int clusterStart = index - index % clusterSize;
+    const int clusterEnd = qMin(clusterStart + clusterSize, this->options.maps);
+    const int col = (index - clusterStart) % clusterWidth;
+    const int row = (index - clusterStart) / clusterWidth;
+
+    OrderedJson::object mapObj;
+    mapObj["id"] = this->mapConstants.at(index);
+    mapObj["name"] = name;
+    mapObj["layout"] = numberedName("LAYOUT_BENCH_LAYOUT", index % this->options.layouts);
+    mapObj["music"] = numberedName("MUS_BENCH_", index % count);
+    mapObj["region_map_section"] = numberedName("MAPSEC_BENCH_", (index / clusterSize) % qMin(count, 200));
+    mapObj["requires_flash"] = false;
+    mapObj["weather"] = "WEATHER_SUNNY";
+    mapObj["map_type"] = "MAP_TYPE_ROUTE";
+    mapObj["allow_cycling"] = true;
+    mapObj["allow_escaping"] = false;
+    mapObj["allow_running"] = true;
+    mapObj["show_map_name"] = true;
+    mapObj["battle_scene"] = "MAP_BATTLE_SCENE_NORMAL";
+
+    // Connect the map to its neighbors in the cluster's grid.
+    OrderedJson::array connectionsArr;
+    auto addConnection = [&](int neighbor, const QString &direction) {
+        if (neighbor < clusterStart || neighbor >= clusterEnd)
+            return;
+        OrderedJson::object connectionObj;
+        connectionObj["map"] = this->mapConstants.at(neighbor);
+        connectionObj["offset"] = 0;
+        connectionObj["direction"] = direction;
+        connectionsArr.push_back(connectionObj);
+    };
+    if (row > 0)
+        addConnection(index - clusterWidth, "up");
+    if (row < clusterWidth - 1)
+        addConnection(index + clusterWidth, "down");
+    if (col > 0)
+        addConnection(index - 1, "left");
+    if (col < clusterWidth - 1)
+        addConnection(index + 1, "right");
+    mapObj["connections"] = connectionsArr;
+
+    OrderedJson::array objectEventsArr;
+    OrderedJson::array warpEventsArr;
+    OrderedJson::array coordEventsArr;
+    OrderedJson::array bgEventsArr;
+    for (int i = 0; i < this->options.eventsPerMap; i++) {
+        const int constant = (index * this->options.eventsPerMap + i) % count;
+        const QString script = numberedName(name + "_EventScript_", i % this->options.scriptsPerMap);
+        OrderedJson::object eventObj;
+        eventObj["x"] = (i * 7 + 3) % width;
+        eventObj["y"] = (i * 5 + 2) % height;
+        eventObj["elevation"] = 3;
+        switch (i % 4) {
+        case 0:
+            eventObj["graphics_id"] = numberedName("OBJ_EVENT_GFX_BENCH_", i % qMin(count, 239));
+            eventObj["movement_type"] = "MOVEMENT_TYPE_LOOK_AROUND";
+            eventObj["movement_range_x"] = 1;
+            eventObj["movement_range_y"] = 1;
+            eventObj["trainer_type"] = "TRAINER_TYPE_NONE";
+            eventObj["trainer_sight_or_berry_tree_id"] = "0";
+            eventObj["script"] = script;
+            eventObj["flag"] = numberedName("FLAG_BENCH_", constant);
+            objectEventsArr.push_back(eventObj);
+            break;
+        case 1:
+            eventObj["dest_map"] = this->mapConstants.at(clusterStart + (index - clusterStart + 1) % (clusterEnd - clusterStart));
+            eventObj["dest_warp_id"] = "0";
+            warpEventsArr.push_back(eventObj);
+            break;
+        case 2:
+            eventObj["type"] = "trigger";
+            eventObj["var"] = numberedName("VAR_BENCH_", constant);
+            eventObj["var_value"] = "0";
+            eventObj["script"] = script;
+            coordEventsArr.push_back(eventObj);
+            break;
+        default:
+            if (i % 8 == 3) {
+                eventObj["type"] = "sign";
+                eventObj["player_facing_dir"] = "BG_EVENT_PLAYER_FACING_ANY";
+                eventObj["script"] = script;
+            } else {
+                eventObj["type"] = "hidden_item";
+                eventObj["item"] = numberedName("ITEM_BENCH_", constant);
+                eventObj["flag"] = numberedName("FLAG_BENCH_", constant);
+            }
+            bgEventsArr.push_back(eventObj);
+            break;
+        }
+    }
+    mapObj["object_events"] = objectEventsArr;
+    mapObj["warp_events"] = warpEventsArr;
+    mapObj["coord_events"] = coordEventsArr;
+    mapObj["bg_events"] = bgEventsArr;
+
+    OrderedJson mapJson(mapObj);
+    this->writeFile(QString("data/maps/%1/map.json").arg(name), OrderedJsonDoc(&mapJson).toUtf8());
+}
+
+void ProjectGenerator::writeScripts() {
+    QString eventScripts;
+    for (const QString &name : this->mapNames) {
+        QString text = QString("%1_MapScripts::\n\t.byte 0\n\n").arg(name);
+        for (int i = 0; i < this->options.scriptsPerMap; i++) {
+            const QString script = numberedName(name + "_EventScript_", i);
+            const QString textLabel = numberedName(name + "_Text_", i);
+            text += QString("%1::\n\tlock\n\tfaceplayer\n\tmsgbox %2, MSGBOX_DEFAULT\n\trelease\n\tend\n\n").arg(script).arg(textLabel);
+            text += QString("%1:\n\t.string \"This is benchmark text %2.$\"\n\n").arg(textLabel).arg(i);
+        }
+        this->writeFile(QString("data/maps/%1/scripts.inc").arg(name), text.toUtf8());
+        eventScripts += QString("\t.include \"data/maps/%1/scripts.inc\"\n").arg(name);
+    }
+    this->writeFile("data/event_scripts.s", eventScripts.toUtf8());
+
+    QString commonScripts;
+    for (int i = 0; i < this->options.scriptsPerMap; i++)
+        commonScripts += QString("%1::\n\tend\n\n").arg(numberedName("Common_EventScript_Bench", i));
+    this->writeFile("data/scripts/bench.inc", commonScripts.toUtf8());
+}
+
+// Each encounter has every encounter type, with a full list of wild pokémon.
+OrderedJson ProjectGenerator::buildWildEncounters(const QStringList &mapConstants, int numEncounters, int numSpecies) {
+    struct Field {
+        QString type;
+        QVector<int> rates;
+        QVector<QPair<QString, QVector<int>>> groups;
+    };
+    const QVector<Field> fields = {
+        {"land_mons", {20, 20, 10, 10, 10, 10, 5, 5, 4, 4, 1, 1}, {}},
+        {"water_mons", {60, 30, 5, 4, 1}, {}},
+        {"rock_smash_mons", {60, 30, 5, 4, 1}, {}},
+        {"fishing_mons", {70, 30, 60, 20, 20, 40, 40, 15, 4, 1}, {{"old_rod", {0, 1}}, {"good_rod", {2, 3, 4}}, {"super_rod", {5, 6, 7, 8, 9}}}},
+    };
+
+    OrderedJson::array fieldsArr;
+    for (const Field &field : fields) {
+        OrderedJson::object fieldObj;
+        fieldObj["type"] = field.type;
+        OrderedJson::array ratesArr;
+        for (int rate : field.rates)
+            ratesArr.push_back(rate);
+        fieldObj["encounter_rates"] = ratesArr;
+        if (!field.groups.isEmpty()) {
+            OrderedJson::object groupsObj;
+            for (const auto &group : field.groups) {
+                OrderedJson::array slotsArr;
+                for (int slot : group.second)
+                    slotsArr.push_back(slot);
+                groupsObj[group.first] = slotsArr;
+            }
+            fieldObj["groups"] = groupsObj;
+        }
+        fieldsArr.push_back(fieldObj);
+    }
+
+    OrderedJson::array encountersArr;
+    for (int i = 0; i < numEncounters && !mapConstants.isEmpty(); i++) {
+        const QString mapConstant = mapConstants.at(i % mapConstants.length());
+        OrderedJson::object encounterObj;
+        encounterObj["map"] = mapConstant;
+        encounterObj["base_label"] = QString("g%1_%2").arg(mapConstant).arg(i);
+        for (int j = 0; j < fields.length(); j++) {
+            const Field &field = fields.at(j);
+            OrderedJson::array monsArr;
+            for (int k = 0; k < field.rates.length(); k++) {
+                const int level = 2 + (i + k) % 60;
+                OrderedJson::object monObj;
+                monObj["min_level"] = level;
+                monObj["max_level"] = level + k % 5;
+                monObj["species"] = speciesName((i * 31 + j * 7 + k) % qMax(1, numSpecies));
+                monsArr.push_back(monObj);
+            }
+            OrderedJson::object fieldObj;
+            fieldObj["encounter_rate"] = 4 + (i + j) % 20;
+            fieldObj["mons"] = monsArr;
+            encounterObj[field.type] = fieldObj;
+        }
+        encountersArr.push_back(encounterObj);
+    }
+
+    OrderedJson::object groupObj;
+    groupObj["label"] = "gWildMonHeaders";
+    groupObj["for_maps"] = true;
+    groupObj["fields"] = fieldsArr;
+    groupObj["encounters"] = encountersArr;
+
+    OrderedJson::array groupsArr;
+    groupsArr.push_back(groupObj);
+    OrderedJson::object wildEncountersObj;
+    wildEncountersObj["wild_encounter_groups"] = groupsArr;
+    return OrderedJson(wildEncountersObj);
+}
+
+void ProjectGenerator::writeWildEncounters() {
+    OrderedJson wildEncountersJson = buildWildEncounters(this->mapConstants, this->options.encounters, this->options.constants);
+    this->writeFile("src/data/wild_encounters.json", OrderedJsonDoc(&wildEncountersJson).toUtf8());
+}
+
+void ProjectGenerator::writeMiscellaneous() {
+    // One heal location in the first map of each cluster.
+    QString healLocationConstants;
+    QString healLocations = "static const struct HealLocation sHealLocations[] =\n{\n";
+    for (int i = 0; i < this->options.maps; i += clusterSize) {
+        const QString mapConstant = QString(this->mapConstants.at(i)).remove(QRegularExpression("^MAP_"));
+        const QString healLocation = "HEAL_LOCATION_" + mapConstant;
+        healLocationConstants += QString("#define %1 %2\n").arg(healLocation).arg(i / clusterSize + 1);
+        healLocations += QString("    [%1 - 1] = {MAP_GROUP(%2), MAP_NUM(%2), %3, %4},\n")
+                .arg(healLocation).arg(mapConstant).arg(qMin(5, this->options.mapWidth - 1)).arg(qMin(5, this->options.mapHeight - 1));
+    }
+    healLocations += "};\n";
+    this->writeFile("include/constants/heal_locations.h", healLocationConstants.toUtf8());
+    this->writeFile("src/data/heal_locations.h", healLocations.toUtf8());
+
+    this->writeFile("src/event_object_movement.c",
+        "const u8 gInitialMovementTypeFacingDirections[] = {\n"
+        "    [MOVEMENT_TYPE_NONE] = DIR_SOUTH,\n"
+        "    [MOVEMENT_TYPE_LOOK_AROUND] = DIR_SOUTH,\n"
+        "    [MOVEMENT_TYPE_WANDER_AROUND] = DIR_SOUTH,\n"
+        "    [MOVEMENT_TYPE_FACE_UP] = DIR_NORTH,\n"
+        "    [MOVEMENT_TYPE_FACE_DOWN] = DIR_SOUTH,\n"
+        "    [MOVEMENT_TYPE_FACE_LEFT] = DIR_WEST,\n"
+        "    [MOVEMENT_TYPE_FACE_RIGHT] = DIR_EAST,\n"
+        "};\n");
+
+    // Porymap reads these too, but the benchmarks don't need anything from them.
+    const QStringList emptyFiles = {
+        "src/fieldmap.c",
+        "src/pokemon_icon.c",
+        "src/data/graphics/pokemon.h",
+        "src/data/object_events/object_event_graphics_info_pointers.h",
+        "src/data/object_events/object_event_graphics_info.h",
+        "src/data/object_events/object_event_pic_tables.h",
+        "src/data/object_events/object_event_graphics.h",
+    };
+    for (const QString &path : emptyFiles)
+        this->writeFile(path, QByteArray());
+}
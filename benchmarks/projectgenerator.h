@@ -0,0 +1,63 @@
+#pragma once
+#ifndef PROJECTGENERATOR_H
+#define PROJECTGENERATOR_H
+
+#include "orderedjson.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+// Writes a synthetic project in the pokeemerald layout, with as many maps, layouts, tilesets, events,
+// constants, scripts and wild encounters as requested. The maps are arranged in clusters of up to 3x3 maps
+// connected to each other, and each cluster is its own map group.
+class ProjectGenerator
+{
+public:
+    struct Options {
+        int maps = 100;
+        int layouts = 0; // 0 gives each map its own layout
+        int tilesets = 4; // The number of primary tilesets, and of secondary tilesets
+        int eventsPerMap = 20;
+        int constants = 1000;
+        int scriptsPerMap = 10;
+        int encounters = 100;
+        int mapWidth = 40;
+        int mapHeight = 40;
+    };
+
+    explicit ProjectGenerator(const Options &options);
+
+    bool generate(const QString &root);
+    int getNumFiles() const { return numFiles; }
+    qint64 getNumBytes() const { return numBytes; }
+
+    static QString mapName(int index);
+    static QString speciesName(int index);
+    static poryjson::Json buildWildEncounters(const QStringList &mapConstants, int numEncounters, int numSpecies);
+
+private:
+    Options options;
+    QString root;
+    QStringList mapNames;
+    QStringList mapConstants;
+    QStringList layoutNames;
+    QStringList primaryTilesets;
+    QStringList secondaryTilesets;
+    int numFiles = 0;
+    qint64 numBytes = 0;
+    bool failed = false;
+
+    void writeFile(const QString &path, const QByteArray &data);
+    void writeConstants();
+    void writeTilesets();
+    void writeTileset(const QString &dir, bool isSecondary, int index);
+    void writeLayouts();
+    void writeMaps();
+    void writeMap(int index);
+    void writeScripts();
+    void writeWildEncounters();
+    void writeMiscellaneous();
+};
+
+#endif // PROJECTGENERATOR_H
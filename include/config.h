@@ -10,6 +10,7 @@
 #include <QMultiMap>
 
 #include "events.h"
+#include "log.h"
 
 // In both versions the default new map border is a generic tree
 #define DEFAULT_BORDER_RSE (QList<uint16_t>{0x1D4, 0x1D5, 0x1DC, 0x1DD})
@@ -74,6 +75,7 @@ public:
         this->paletteEditorBitDepth = 24;
         this->projectSettingsTab = 0;
         this->warpBehaviorWarningDisabled = false;
+        this->logLevel = LogType::LOG_INFO;
     }
     void addRecentProject(QString project);
     void setRecentProjects(QStringList projects);
@@ -135,6 +137,7 @@ public:
     int getPaletteEditorBitDepth();
     int getProjectSettingsTab();
     bool getWarpBehaviorWarningDisabled();
+    LogType getLogLevel();
 protected:
     virtual QString getConfigFilepath() override;
     virtual void parseConfigKeyValue(QString key, QString value) override;
@@ -183,6 +186,7 @@ private:
     int paletteEditorBitDepth;
     int projectSettingsTab;
     bool warpBehaviorWarningDisabled;
+    LogType logLevel;
 };
 
 extern PorymapConfig porymapConfig;
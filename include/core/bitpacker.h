@@ -22,6 +22,10 @@ private:
     uint32_t m_mask = 0;
     uint32_t m_maxValue = 0;
     QList<uint32_t> m_setBits;
+
+    // Masks with only contiguous bits (by far the most common) can skip the per-bit loops.
+    bool m_contiguous = true;
+    int m_shift = 0;
 };
 
 #endif // BITPACKER_H
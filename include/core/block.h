@@ -10,8 +10,8 @@ public:
     Block();
     Block(uint16_t);
     Block(uint16_t metatileId, uint16_t collision, uint16_t elevation);
-    Block(const Block &);
-    Block &operator=(const Block &);
+    Block(const Block &) = default;
+    Block &operator=(const Block &) = default;
     bool operator ==(Block) const;
     bool operator !=(Block) const;
     void setMetatileId(uint16_t metatileId);
@@ -34,4 +34,7 @@ private:
     uint16_t m_elevation;
 };
 
+// Blocks are plain values, so containers of them (e.g. Blockdata) can be copied and compared as raw memory.
+Q_DECLARE_TYPEINFO(Block, Q_PRIMITIVE_TYPE);
+
 #endif // BLOCK_H
@@ -11,6 +11,18 @@ class Blockdata : public QVector<Block>
 {
 public:
     QByteArray serialize() const;
+    static Blockdata deserialize(const QByteArray &data);
+
+    // Compact single-field copies of the blockdata, for anything that only needs to read/compare one kind of data.
+    // Metatile IDs are stored as-is, collision and elevation are combined as (collision << 16) | elevation.
+    QVector<uint16_t> metatileIdPlane() const;
+    QVector<uint32_t> collisionPlane() const;
+    static uint32_t collisionPlaneValue(const Block &block) {
+        return (static_cast<uint32_t>(block.collision()) << 16) | block.elevation();
+    }
+
+    bool operator==(const Blockdata &other) const;
+    bool operator!=(const Blockdata &other) const { return !(operator==(other)); }
 };
 
 #endif // BLOCKDATA_H
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CONSTANTLISTMODEL_H
+#define CONSTANTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+
+// A read-only list of project constants (e.g. flags, vars, items), shared by every combo box that lists them.
+// Lookups for a name or for names starting with some text don't need to search the full list.
+class ConstantListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    ConstantListModel(const QStringList &names, const QVariantList &values = QVariantList(), QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QModelIndexList match(const QModelIndex &start, int role, const QVariant &value, int hits = 1,
+                          Qt::MatchFlags flags = Qt::MatchFlags(Qt::MatchStartsWith | Qt::MatchWrap)) const override;
+
+    const QStringList &names() const { return this->m_names; }
+    const QVariantList &values() const { return this->m_values; }
+    int indexOf(const QString &name) const { return this->m_rows.value(name, -1); }
+    QList<int> rowsWithPrefix(const QString &prefix) const;
+
+    // The project replaces a model when its list changes, and the old model is deleted once nothing uses it.
+    void addUser(QObject *user);
+    void removeUser(QObject *user);
+    void setSuperseded();
+
+private:
+    const QStringList m_names;
+    const QVariantList m_values;
+
+    // Row of the first occurrence of each name
+    QHash<QString, int> m_rows;
+
+    // Rows sorted by their lowercase names, for finding names by prefix
+    QStringList m_sortedNames;
+    QVector<int> m_sortedRows;
+
+    QHash<QObject*, QMetaObject::Connection> m_users;
+    bool m_superseded = false;
+
+    void deleteIfUnused();
+};
+
+#endif // CONSTANTLISTMODEL_H
@@ -4,6 +4,7 @@
 
 #include <QString>
 #include <QMap>
+#include <QHash>
 #include <QSet>
 #include <QPixmap>
 #include <QJsonObject>
@@ -44,10 +45,20 @@ public:
 
 struct EventGraphics
 {
+    // The spritesheet is only decoded when it's first needed, see Project::loadEventGraphics.
+    QString filepath;
     QImage spritesheet;
+    bool loaded = false;
     int spriteWidth;
     int spriteHeight;
     bool inanimate;
+
+    QPixmap getFrame(int frame, bool hFlip);
+    void unload();
+
+    // Frames already cut from the spritesheet, keyed by frame index and horizontal flip.
+    // These are shared by every event using these graphics.
+    QHash<QPair<int, bool>, QPixmap> frames;
 };
 
 
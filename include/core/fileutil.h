@@ -0,0 +1,14 @@
+#pragma once
+#ifndef FILEUTIL_H
+#define FILEUTIL_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace FileUtil {
+    bool contentsEqual(const QString &filepath, const QByteArray &data);
+    QByteArray hash(const QString &filepath);
+    bool writeIfChanged(const QString &filepath, const QByteArray &data, QString *errorString = nullptr);
+}
+
+#endif // FILEUTIL_H
@@ -11,6 +11,7 @@
 #include <QUndoStack>
 #include <QPixmap>
 #include <QObject>
+#include <QHash>
 #include <QGraphicsPixmapItem>
 #include <math.h>
 
@@ -81,8 +82,9 @@ public:
     int getBorderHeight();
     QPixmap render(bool ignoreCache = false, MapLayout *fromLayout = nullptr, QRect bounds = QRect(0, 0, -1, -1));
     QPixmap renderCollision(bool ignoreCache);
-    bool mapBlockChanged(int i, const Blockdata &cache);
-    bool borderBlockChanged(int i, const Blockdata &cache);
+    bool mapBlockChanged(int i, const QVector<uint16_t> &cache);
+    bool collisionBlockChanged(int i, const QVector<uint32_t> &cache);
+    bool borderBlockChanged(int i, const QVector<uint16_t> &cache);
     void cacheBlockdata();
     void cacheCollision();
     bool getBlock(int x, int y, Block *out);
@@ -98,7 +100,24 @@ public:
     QStringList getScriptLabels(Event::Group group = Event::Group::None);
     void removeEvent(Event *);
     void addEvent(Event *);
-    QPixmap renderConnection(MapConnection, MapLayout *);
+    QPixmap renderConnection(MapConnection, MapLayout *, bool ignoreCache = false);
+    void clearConnectionCache();
+
+    // Images of the map and its collision rendered ahead of time (see MapPrefetcher), and what they were rendered from.
+    struct PrerenderedImages {
+        QImage image;
+        QImage collisionImage;
+        QVector<uint16_t> metatileIds;
+        QVector<uint32_t> collision;
+        Tileset *primaryTileset = nullptr;
+        Tileset *secondaryTileset = nullptr;
+        QList<int> layerOrder;
+        QList<float> layerOpacity;
+    };
+    bool setPrerenderedImages(const PrerenderedImages &images, int revision);
+    void clearPrerenderedImages();
+    int getPrerenderRevision() const { return prerenderRevision; }
+    bool hasPrerenderedImages() const { return !prerendered.image.isNull(); }
     QPixmap renderBorder(bool ignoreCache = false);
     void setDimensions(int newWidth, int newHeight, bool setNewBlockdata = true, bool enableScriptCallback = false);
     void setBorderDimensions(int newWidth, int newHeight, bool setNewBlockdata = true, bool enableScriptCallback = false);
@@ -125,6 +144,23 @@ public:
 
 private:
     void setNewDimensionsBlockdata(int newWidth, int newHeight);
+
+    // The last image rendered for each connection direction, and what it was rendered from.
+    struct ConnectionStrip {
+        QRect bounds;
+        QVector<uint16_t> metatileIds;
+        Tileset *primaryTileset = nullptr;
+        Tileset *secondaryTileset = nullptr;
+        QList<int> layerOrder;
+        QList<float> layerOpacity;
+        QPixmap pixmap;
+    };
+    QHash<QString, ConnectionStrip> connectionStrips;
+
+    PrerenderedImages prerendered;
+    int prerenderRevision = 0;
+    bool takePrerenderedImage();
+    bool takePrerenderedCollisionImage();
     void setNewBorderDimensionsBlockdata(int newWidth, int newHeight);
 
 signals:
@@ -28,9 +28,9 @@ public:
     QImage border_image;
     QPixmap border_pixmap;
     Blockdata border;
-    Blockdata cached_blockdata;
-    Blockdata cached_collision;
-    Blockdata cached_border;
+    QVector<uint16_t> cached_blockdata; // Metatile IDs of the last rendered blockdata
+    QVector<uint32_t> cached_collision; // See Blockdata::collisionPlane
+    QVector<uint16_t> cached_border;    // Metatile IDs of the last rendered border
     struct {
         Blockdata blocks;
         QSize mapDimensions;
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef MAPPREFETCHER_H
+#define MAPPREFETCHER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+
+class Project;
+class Map;
+
+// While the user stays on a map, loads the maps they're likely to open next (e.g. its connections and warp destinations)
+// and renders their map and collision images in the background. Opening one of those maps then only has to display the images.
+class MapPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MapPrefetcher(QObject *parent = nullptr);
+    void prefetch(Project *project, const QStringList &mapNames);
+    void cancel();
+
+private:
+    void prefetchNext();
+    bool canPrefetch(const QString &mapName) const;
+    void prerender(Map *map);
+
+    QPointer<Project> project;
+    QStringList queue;
+    QStringList prerenderedMaps;
+    QTimer timer;
+
+    // Incremented when prefetching is cancelled, so that images still being rendered for earlier requests are discarded.
+    int generation = 0;
+};
+
+#endif // MAPPREFETCHER_H
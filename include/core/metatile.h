@@ -8,6 +8,7 @@
 #include <QImage>
 #include <QPoint>
 #include <QString>
+#include <QVector>
 
 class Project;
 
@@ -76,6 +77,10 @@ public:
     static void setLayout(Project*);
     static QString getMetatileIdString(uint16_t metatileId);
     static QString getMetatileIdStrings(const QList<uint16_t> metatileIds);
+    static QList<Metatile*> deserializeTiles(const QByteArray &data, int numTiles);
+    static QByteArray serializeTiles(const QList<Metatile*> &metatiles, int numTiles);
+    static QVector<uint32_t> deserializeAttributes(const QByteArray &data, int attrSize);
+    static QByteArray serializeAttributes(const QList<Metatile*> &metatiles, int attrSize);
 
     inline bool operator==(const Metatile &other) {
         return this->tiles == other.tiles && this->attributes == other.attributes;
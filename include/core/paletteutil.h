@@ -2,11 +2,13 @@
 #ifndef PALETTEUTIL_H
 #define PALETTEUTIL_H
 
+#include <QByteArray>
 #include <QList>
 #include <QRgb>
 
 namespace PaletteUtil {
     QList<QRgb> parse(QString filepath, bool *error);
+    QByteArray serializeJASC(const QVector<QRgb> &colors, int offset, int nColors);
     void writeJASC(QString filepath, QVector<QRgb> colors, int offset, int nColors);
 }
 
@@ -39,6 +39,13 @@ public:
     int operatorPrecedence; // only relevant for operator tokens
 };
 
+// A label defined in a script file
+struct ScriptLabel {
+    QString name;
+    int lineNumber;
+    bool global;
+};
+
 class ParseUtil
 {
 public:
@@ -62,7 +69,9 @@ public:
     QStringList getLabelValues(const QList<QStringList>&, const QString&);
     bool tryParseJsonFile(QJsonDocument *out, const QString &filepath);
     bool tryParseOrderedJsonFile(poryjson::Json::object *out, const QString &filepath);
+    bool tryParseOrderedJsonFile(poryjson::Json *out, const QString &filepath);
     bool ensureFieldsExist(const QJsonObject &obj, const QList<QString> &fields);
+    static bool readJsonFields(const QByteArray &json, const QStringList &keys, QJsonObject *out);
 
     // Returns the 1-indexed line number for the definition of scriptLabel in the scripts file at filePath.
     // Returns 0 if a definition for scriptLabel cannot be found.
@@ -72,6 +81,9 @@ public:
     static QStringList getGlobalScriptLabels(const QString &filePath);
     static QStringList getGlobalRawScriptLabels(QString text);
     static QStringList getGlobalPoryScriptLabels(QString text);
+    static QList<ScriptLabel> readScriptLabels(const QString &filePath);
+    static QList<ScriptLabel> getRawScriptLabels(QString text, int firstLineNumber = 1);
+    static QList<ScriptLabel> getPoryScriptLabels(QString text);
     static QString removeStringLiterals(QString text);
     static QString removeLineComments(QString text, const QString &commentSymbol);
     static QString removeLineComments(QString text, const QStringList &commentSymbols);
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <QString>
+#include <atomic>
+
+// Collects how long the slower operations in porymap take (e.g. reading project files, rendering maps, saving).
+// Profiling is off unless porymap is started with the PORYMAP_PROFILE environment variable set, and then a summary
+// of each operation's calls, total/mean/99th percentile time, bytes and cache hits is logged when porymap closes.
+// If PORYMAP_TRACE is set to a file path, the operations are also written there as a Chrome trace-event JSON file,
+// which can be opened with chrome://tracing or https://ui.perfetto.dev.
+namespace Profiling {
+    extern std::atomic<bool> enabled;
+    inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    void init();
+    void finish();
+    qint64 now();
+    void record(const QString &name, qint64 start, qint64 duration);
+    void addBytes(const QString &name, qint64 bytes);
+    void addCacheResult(const QString &name, bool hit);
+    QString summary();
+    qint64 peakMemoryUsage();
+    bool writeTrace(const QString &filepath);
+}
+
+// Records how long the enclosing scope takes under the given name.
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char *name) : name(name) {
+        if (Profiling::isEnabled())
+            this->start = Profiling::now();
+    }
+    explicit ScopedTimer(const QString &name) : dynamicName(name) {
+        if (Profiling::isEnabled())
+            this->start = Profiling::now();
+    }
+    ~ScopedTimer() {
+        if (this->start >= 0 && Profiling::isEnabled())
+            Profiling::record(this->name ? QString(this->name) : this->dynamicName, this->start, Profiling::now() - this->start);
+    }
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    const char *name = nullptr;
+    QString dynamicName;
+    qint64 start = -1;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_CONCAT(scopedTimer_, __LINE__)(name)
+
+#endif // PROFILING_H
@@ -52,9 +52,9 @@ public:
 
     Project *project = nullptr;
 
-    bool loadMapData(poryjson::Json);
-    bool loadTilemap(poryjson::Json);
-    bool loadLayout(poryjson::Json);
+    bool loadMapData(const poryjson::Json &);
+    bool loadTilemap(const poryjson::Json &);
+    bool loadLayout(const poryjson::Json &);
     bool loadEntries();
 
     void setEntries(tsl::ordered_map<QString, MapSectionEntry> *entries) { this->region_map_entries = entries; }
@@ -28,6 +28,7 @@
 
 class DraggablePixmapItem;
 class MetatilesPixmapItem;
+class MonTabWidget;
 
 class Editor : public QObject
 {
@@ -65,6 +66,7 @@ public:
     void displayMapBorder();
     void displayMapGrid();
     void displayWildMonTables();
+    void clearWildMonTables();
 
     void updateMapBorder();
     void updateMapConnections();
@@ -115,8 +117,7 @@ public:
     QGraphicsPathItem *connection_mask = nullptr;
     CollisionPixmapItem *collision_item = nullptr;
     QGraphicsItemGroup *events_group = nullptr;
-    QList<QGraphicsPixmapItem*> borderItems;
-    QList<QGraphicsLineItem*> gridLines;
+    QGraphicsRectItem *borderItem = nullptr;
     MovableRect *playerViewRect = nullptr;
     CursorTileRect *cursorMapTileRect = nullptr;
     MapRuler *map_ruler = nullptr;
@@ -164,12 +165,16 @@ public slots:
     void selectedEventIndexChanged(int index, Event::Group eventGroup);
 
 private:
+    QList<MonTabWidget *> unusedMonTabWidgets;
+    MonTabWidget *takeMonTabWidget();
+
     const QImage defaultCollisionImgSheet = QImage(":/images/collisions.png");
     const QImage collisionPlaceholder = QImage(":/images/collisions_unknown.png");
     QPixmap collisionSheetPixmap;
 
     void setConnectionItemsVisible(bool);
-    void setBorderItemsVisible(bool, qreal = 1);
+    void setBorderItemVisible(bool, qreal = 1);
+    void setBorderPixmap(const QPixmap &pixmap);
     void setConnectionEditControlValues(MapConnection*);
     void setConnectionEditControlsEnabled(bool);
     void setConnectionsEditable(bool);
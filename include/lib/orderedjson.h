@@ -90,6 +90,37 @@ enum JsonParse {
 
 class JsonValue;
 
+// Serializes JSON as UTF-8 into a buffer. If a device is given, the buffer is written
+// to the device in chunks as it fills, rather than building the whole document in memory.
+class JsonWriter {
+public:
+    JsonWriter(QIODevice *device = nullptr, int indent = 0, bool afterKey = false);
+    ~JsonWriter();
+
+    JsonWriter(const JsonWriter &) = delete;
+    JsonWriter & operator = (const JsonWriter &) = delete;
+
+    void flush();
+    const QByteArray &buffer() const { return m_buffer; }
+
+    void beginValue();
+    void endValue();
+    void writeKey(const QString &key);
+    void writeString(const QString &value);
+    void writeIndent();
+    void write(const char *data, int length) { m_buffer.append(data, length); }
+    void write(char c) { m_buffer.append(c); }
+    void increaseIndent() { m_indent++; }
+    void decreaseIndent() { m_indent--; }
+
+private:
+    static const int flush_size = 1 << 16;
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    int m_indent;
+    bool m_afterKey;
+};
+
 class Json final {
 public:
     // Types
@@ -167,8 +198,12 @@ public:
     const Json & operator[](int i) const;
     // Return a reference to obj[key] if this is an object, Json() otherwise.
     const Json & operator[](const QString &key) const;
+    // Return true if this is an object that contains key.
+    bool has_key(const QString &key) const { return object_items().contains(key); }
 
     // Serialize.
+    void dump(JsonWriter &writer) const;
+    void dump(QIODevice *device, int indent = 0) const;
     void dump(QString &out, int *) const;
     QString dump(int *indent = nullptr) const {
         QString out;
@@ -181,6 +216,10 @@ public:
     }
 
     // Parse. If parse fails, return Json() and assign an error message to err.
+    // The input is parsed as UTF-8, so parsing file contents directly avoids converting them to a QString first.
+    static Json parse(const QByteArray & in,
+                      QString & err,
+                      JsonParse strategy = JsonParse::STANDARD);
     static Json parse(const QString & in,
                       QString & err,
                       JsonParse strategy = JsonParse::STANDARD);
@@ -188,7 +227,7 @@ public:
                       QString & err,
                       JsonParse strategy = JsonParse::STANDARD) {
         if (in) {
-            return parse(QString(in), err, strategy);
+            return parse(QByteArray(in), err, strategy);
         } else {
             err = "null input";
             return nullptr;
@@ -214,9 +253,15 @@ public:
     };
 
     void dump(QFile *file) {
-        QTextStream fileStream(file);
-        fileStream << m_obj->dump(&m_indent);
-        fileStream << "\n"; // pad file with newline
+        m_obj->dump(file, m_indent);
+        file->write("\n"); // pad file with newline
+    }
+
+    QByteArray toUtf8() {
+        JsonWriter writer(nullptr, m_indent);
+        m_obj->dump(writer);
+        writer.write('\n'); // pad file with newline
+        return writer.buffer();
     }
 
 private:
@@ -233,7 +278,7 @@ protected:
     virtual Json::Type type() const = 0;
     virtual bool equals(const JsonValue * other) const = 0;
     virtual bool less(const JsonValue * other) const = 0;
-    virtual void dump(QString &out, int *indent) const = 0;
+    virtual void dump(JsonWriter &writer) const = 0;
     virtual double number_value() const;
     virtual int int_value() const;
     virtual bool bool_value() const;
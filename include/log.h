@@ -19,8 +19,10 @@ void logInfo(QString message);
 void logWarn(QString message);
 void logError(QString message);
 void log(QString message, LogType type);
+void logInit();
+void setLogLevel(LogType type);
+bool logLevelEnabled(LogType type);
 QString getLogPath();
 QString getMostRecentError();
-bool cleanupLargeLog();
 
 #endif // LOG_H
@@ -20,7 +20,8 @@
 #include "tileseteditor.h"
 #include "regionmapeditor.h"
 #include "mapimageexporter.h"
-#include "filterchildrenproxymodel.h"
+#include "maplistmodel.h"
+#include "mapprefetcher.h"
 #include "newmappopup.h"
 #include "newtilesetdialog.h"
 #include "shortcutseditor.h"
@@ -184,6 +185,7 @@ private slots:
     void openNewMapPopupWindow();
     void onNewMapCreated();
     void onMapCacheCleared();
+    void onProjectDataReloaded();
     void importMapFromAdvanceMap1_92();
     void onMapRulerStatusChanged(const QString &);
     void applyUserShortcuts();
@@ -298,6 +300,9 @@ public:
     Editor *editor = nullptr;
 
 private:
+    // Opens projects and maps the same way the user would (see benchmarks/benchmarks.cpp).
+    friend class Benchmarks;
+
     QLabel *label_MapRulerStatus = nullptr;
     QPointer<TilesetEditor> tilesetEditor = nullptr;
     QPointer<RegionMapEditor> regionMapEditor = nullptr;
@@ -307,13 +312,9 @@ private:
     QPointer<PreferenceEditor> preferenceEditor = nullptr;
     QPointer<ProjectSettingsEditor> projectSettingsEditor = nullptr;
     QPointer<CustomScriptsEditor> customScriptsEditor = nullptr;
-    FilterChildrenProxyModel *mapListProxyModel;
-    QStandardItemModel *mapListModel;
-    QList<QStandardItem*> *mapGroupItemsList;
-    QMap<QString, QModelIndex> mapListIndexes;
-    QIcon* mapIcon;
-    QIcon* mapEditedIcon;
-    QIcon* mapOpenedIcon;
+    MapListProxyModel *mapListProxyModel;
+    MapListModel *mapListModel;
+    MapPrefetcher *mapPrefetcher;
 
     QAction *undoAction = nullptr;
     QAction *redoAction = nullptr;
@@ -351,11 +352,10 @@ private:
     void showProjectOpenFailure();
     bool setInitialMap();
     void setRecentMap(QString map_name);
-    QStandardItem* createMapItem(QString mapName, int groupNum, int inGroupNum);
     void refreshRecentProjectsMenu();
 
-    void drawMapListIcons(QAbstractItemModel *model);
     void updateMapList();
+    void prefetchMaps();
 
     void displayMapProperties();
     void checkToolButtons();
@@ -397,10 +397,4 @@ private:
     int insertTilesetLabel(QStringList * list, QString label);
 };
 
-enum MapListUserRoles {
-    GroupRole = Qt::UserRole + 1, // Used to hold the map group number.
-    TypeRole,  // Used to differentiate between the different layers of the map list tree view.
-    TypeRole2, // Used for various extra data needed.
-};
-
 #endif // MAINWINDOW_H
@@ -9,6 +9,7 @@
 #include "parseutil.h"
 #include "orderedjson.h"
 #include "regionmap.h"
+#include "constantlistmodel.h"
 
 #include <QStringList>
 #include <QList>
@@ -17,10 +18,26 @@
 #include <QStandardItem>
 #include <QVariant>
 #include <QFileSystemWatcher>
+#include <QTimer>
+#include <QDateTime>
+#include <QFuture>
+#include <QSet>
+#include <QPixmap>
 
 // The displayed name of the special map value used by warps with multiple potential destinations
 static QString DYNAMIC_MAP_NAME = "Dynamic";
 
+// A few fields from each map's header, read for every map when the project is opened.
+// This allows e.g. sorting the map list without loading or re-reading every map.
+struct MapHeader
+{
+    QString layoutId;
+    QString location;
+    QString type;
+    QString song;
+    QStringList connectedMaps;
+};
+
 class Project : public QObject
 {
     Q_OBJECT
@@ -41,6 +58,7 @@ public:
     QStringList mapNames;
     QMap<QString, QVariant> miscConstants;
     QList<HealLocation> healLocations;
+    int addHealLocation(HealLocation healLocation);
     QMap<QString, int> healLocationNameToValue;
     QMap<QString, QString> mapConstantsToMapNames;
     QMap<QString, QString> mapNamesToMapConstants;
@@ -85,6 +103,10 @@ public:
 
     void initSignals();
 
+    typedef bool (Project::*ReadFunction)();
+    void watchFile(const QString &filepath, ReadFunction reader = nullptr);
+    void stopWatchingFiles();
+
     void clearMapCache();
     void clearTilesetCache();
 
@@ -98,6 +120,7 @@ public:
     QString healLocationsTableName;
 
     QMap<QString, Map*> mapCache;
+    QMap<QString, MapHeader> mapHeaders;
     Map* loadMap(QString);
     Map* getMap(QString);
 
@@ -117,9 +140,11 @@ public:
     void deleteFile(QString path);
 
     bool readMapGroups();
+    bool readMapHeaders();
     Map* addNewMapToGroup(QString, int, Map*, bool, bool);
     QString getNewMapName();
     QString getProjectTitle();
+    ConstantListModel *getListModel(const QString &name, const QStringList &list, const QVariantList &values = QVariantList());
 
     QString readMapLayoutId(QString map_name);
     QString readMapLocation(QString map_name);
@@ -132,7 +157,8 @@ public:
     QVector<poryjson::Json::object> extraEncounterGroups;
 
     bool readSpeciesIconPaths();
-    QMap<QString, QString> speciesToIconPath;
+    const QMap<QString, QString> &getSpeciesIconPaths();
+    QPixmap getSpeciesIcon(const QString &species);
 
     QSet<QString> getTopLevelMapFields();
     bool loadMapData(Map*);
@@ -150,8 +176,10 @@ public:
     void saveLayoutBlockdata(Map*);
     void saveLayoutBorder(Map*);
     void writeBlockdata(QString, const Blockdata &);
+    void writeBlockdata(QString, const QByteArray &);
     void saveAllMaps();
     void saveMap(Map*);
+    void saveMaps(const QList<Map*> &maps);
     void saveAllDataStructures();
     void saveMapLayouts();
     void saveMapGroups();
@@ -164,6 +192,11 @@ public:
     void saveTilesetMetatiles(Tileset*);
     void saveTilesetTilesImage(Tileset*);
     void saveTilesetPalettes(Tileset*);
+    void writeTilesetMetatileAttributes(Tileset*, const QByteArray &);
+    void writeTilesetMetatiles(Tileset*, const QByteArray &);
+    void writeTilesetTilesImage(Tileset*, const QByteArray &);
+    void writeTilesetPalette(Tileset*, int paletteId, const QByteArray &);
+    static QByteArray encodeTilesImage(const QImage &);
     void appendTilesetLabel(QString label, QString isSecondaryStr);
     bool readTilesetLabels();
     bool readTilesetMetatileLabels();
@@ -185,6 +218,8 @@ public:
     bool readHealLocations();
     bool readMiscellaneousConstants();
     bool readEventScriptLabels();
+    QStringList getGlobalScriptLabels(const QString &filePath);
+    bool findScriptLabel(const QString &label, const QString &preferredFilePath, QString *filePath, int *lineNumber);
     bool readObjEventGfxConstants();
     bool readSongNames();
     bool readEventGraphics();
@@ -193,6 +228,7 @@ public:
     QMap<QString, QMap<QString, QString>> readObjEventGfxInfo();
 
     void setEventPixmap(Event *event, bool forceLoad = false);
+    bool loadEventGraphics(EventGraphics *gfx);
 
     QString fixPalettePath(QString path);
     QString fixGraphicPath(QString path);
@@ -229,16 +265,54 @@ public:
 
 private:
     void updateMapLayout(Map*);
+    QByteArray buildMapJson(Map *map, QStringList *errors);
+    void writeMapFiles(Map *map, const QByteArray &mapJson, const QByteArray &border, const QByteArray &blockdata);
 
     void setNewMapBlockdata(Map* map);
     void setNewMapBorder(Map *map);
     void setNewMapEvents(Map *map);
     void setNewMapConnections(Map *map);
 
-    void saveHealLocationsData(Map *map);
+    void updateHealLocations(Map *map);
+    void indexHealLocation(int i);
+    void saveHealLocationsData();
     void saveHealLocationsConstants();
 
     void ignoreWatchedFileTemporarily(QString filepath);
+    void recordWatchedFileChange(const QString &filepath);
+    void processWatchedFileChanges();
+    void writeJsonFile(const QString &filepath, const QByteArray &data);
+
+    QMap<QString, QList<ReadFunction>> watchedFileReaders;
+    QMap<QString, QByteArray> watchedFileHashes;
+    QSet<QString> changedFiles;
+    QTimer fileChangeTimer;
+
+    QHash<QString, QList<int>> healLocationsByMap;
+
+    QHash<QString, ConstantListModel*> listModels;
+
+    struct ScriptFile {
+        QDateTime lastModified;
+        qint64 size;
+        QList<ScriptLabel> labels;
+    };
+    struct ScriptLabelLocation {
+        QString filePath;
+        int lineNumber;
+    };
+    QHash<QString, ScriptFile> scriptFiles;
+    QHash<QString, QList<ScriptLabelLocation>> scriptLabelLocations;
+
+    QMap<QString, QString> speciesToIconPath;
+    QFuture<QMap<QString, QString>> speciesIconPathsFuture;
+    bool readingSpeciesIconPaths = false;
+    QHash<QString, QPixmap> speciesIcons;
+    QSet<QString> loadingSpeciesIcons;
+    int speciesIconsGeneration = 0; // Incremented when the icons are reset, so icons that were loading from old paths are discarded
+
+    QList<EventGraphics*> loadedEventGraphics;
+    qint64 loadedEventGraphicsSize = 0;
 
     static int num_tiles_primary;
     static int num_tiles_total;
@@ -253,6 +327,8 @@ signals:
     void reloadProject();
     void uncheckMonitorFilesAction();
     void mapCacheCleared();
+    void speciesIconLoaded(const QString &species);
+    void dataReloaded();
 };
 
 #endif // PROJECT_H
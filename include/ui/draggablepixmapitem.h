@@ -27,6 +27,7 @@ public:
     Editor *editor = nullptr;
     Event *event = nullptr;
     QGraphicsItemAnimation *pos_anim = nullptr;
+    bool selectionOutline = false;
 
     bool active;
     int last_x;
@@ -37,6 +38,8 @@ public:
     void moveTo(const QPoint &pos);
     void emitPositionChanged();
     void updatePixmap();
+    void setSelectionOutline(bool enabled);
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
 signals:
     void positionChanged(Event *event);
@@ -8,12 +8,13 @@
 
 
 class Project;
+class QAbstractItemView;
 
 class SpeciesComboDelegate : public QStyledItemDelegate {
     Q_OBJECT
 
 public:
-    SpeciesComboDelegate(Project *project, QObject *parent = nullptr);
+    SpeciesComboDelegate(Project *project, QAbstractItemView *view);
 
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
     QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
@@ -24,6 +24,8 @@ public:
     explicit MapImageExporter(QWidget *parent, Editor *editor, ImageExporterMode mode);
     ~MapImageExporter();
 
+    bool writeImage(const QString &filepath);
+
 private:
     Ui::MapImageExporter *ui;
 
@@ -0,0 +1,106 @@
+#ifndef MAPLISTMODEL_H
+#define MAPLISTMODEL_H
+
+#include "config.h"
+
+#include <QAbstractItemModel>
+#include <QSortFilterProxyModel>
+#include <QPointer>
+#include <QIcon>
+#include <QHash>
+#include <QVector>
+
+class Project;
+
+enum MapListUserRoles {
+    GroupRole = Qt::UserRole + 1, // Used to hold the map group number.
+    TypeRole,  // Used to differentiate between the different layers of the map list tree view.
+    TypeRole2, // Used for various extra data needed.
+};
+
+// The tree of folders and maps displayed in the map list.
+// The maps are read once from the project, and changing the sort order only regroups them into new folders.
+// Map icons are provided by data() from the maps' current state, so a change to a map only needs to update its row.
+class MapListModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    explicit MapListModel(QObject *parent = nullptr);
+
+    void setProject(Project *project);
+    void setSortOrder(MapSortOrder sortOrder);
+    void setOpenMap(const QString &mapName);
+    void updateMapIcons();
+    void setFilter(const QString &filter);
+    bool filterAccepts(int row, const QModelIndex &parent) const;
+    QModelIndex indexOfMap(const QString &mapName) const;
+    QStringList getAdjacentMaps(const QString &mapName) const;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct MapEntry {
+        QString name;
+        QString text;
+        QString filterText;
+        int group = 0;
+        int folder = -1;
+        int row = -1;
+    };
+    struct Folder {
+        QString name;
+        QString type;
+        QString layoutId;
+        int groupNum = 0;
+        QVector<int> maps;
+    };
+
+    void readMaps();
+    void buildFolders();
+    void applyFilter();
+    QVector<int> findMaps(const QString &text) const;
+    QIcon getMapIcon(const QString &mapName) const;
+
+    QPointer<Project> project;
+    MapSortOrder sortOrder = MapSortOrder::Group;
+    QVector<MapEntry> maps;
+    QHash<QString, int> mapIds;
+    QVector<Folder> folders;
+    QString openMapName;
+
+    // Maps the (lowercase) 3-character substrings of the map names to the maps that contain them.
+    QHash<quint64, QVector<int>> trigramIndex;
+    QString filter;
+    QVector<bool> mapMatches;
+    QVector<bool> folderMatches;
+    QVector<bool> folderAccepted;
+
+    QIcon mapIcon;
+    QIcon mapEditedIcon;
+    QIcon mapOpenedIcon;
+    QIcon mapFolderIcon;
+    QIcon folderIcon;
+};
+
+// Shows only the rows of a MapListModel that match its filter.
+class MapListProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit MapListProxyModel(MapListModel *model, QObject *parent = nullptr);
+    void setFilterText(const QString &text);
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    MapListModel *model;
+};
+
+#endif // MAPLISTMODEL_H
@@ -74,6 +74,8 @@ private:
     QMap<int, Overlay*> overlayMap;
 protected:
     void drawForeground(QPainter *painter, const QRectF &rect);
+private:
+    void drawGrid(QPainter *painter, const QRectF &rect);
 };
 
 #endif // GRAPHICSVIEW_H
@@ -17,8 +17,13 @@ public:
     ~MonTabWidget();
 
     void populate();
+    void load(const QString &mapConstant, const QString &groupLabel);
     void populateTab(int tabIndex, WildMonInfo monInfo);
     void clear();
+    bool hasFields(const EncounterFields &fields);
+
+    WildMonInfo encounterData(int tabIndex);
+    bool isTabPopulated(int tabIndex);
 
     void clearTableAt(int index);
 
@@ -31,13 +36,23 @@ public slots:
     void setTabActive(int index, bool active = true);
     void deactivateTab(int tabIndex);
 
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private:
     bool eventFilter(QObject *object, QEvent *event);
+    void populateTabOnDemand(int tabIndex);
+    void setTableModel(int tabIndex, QAbstractItemModel *model);
+    WildMonInfo projectEncounterData(int tabIndex);
 
     void actionCopyTab(int index);
     void actionAddDeleteTab(int index);
 
     QVector<bool> activeTabs;
+    QVector<bool> populatedTabs;
+    bool loading = false;
+    QString mapConstant;
+    QString groupLabel;
     QVector<QPushButton *> addDeleteTabButtons;
     QVector<QPushButton *> copyTabButtons;
 
@@ -7,12 +7,18 @@
 #include <QPainter>
 #include <QStaticText>
 #include <QPainterPath>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QPixmap>
+#include <QHash>
 
 class OverlayItem {
 public:
     OverlayItem() {}
     virtual ~OverlayItem() {};
     virtual void render(QPainter *) {};
+    virtual QRectF boundingRect() const { return QRectF(); };
+    virtual void setFont(const QFont &) {};
 };
 
 class OverlayText : public OverlayItem {
@@ -24,15 +30,25 @@ public:
         this->y = y;
         this->color = color;
         this->fontSize = fontSize;
+        this->setFont(QFont());
     }
     ~OverlayText() {}
     virtual void render(QPainter *painter);
+    virtual QRectF boundingRect() const { return this->bounds; };
+    // The text is drawn with the painter's font, so its bounds are measured with the font it will be drawn with.
+    virtual void setFont(const QFont &font) {
+        QFont sizedFont(font);
+        sizedFont.setPixelSize(this->fontSize);
+        QSizeF size = QFontMetricsF(sizedFont).size(0, this->text.text());
+        this->bounds = QRectF(QPointF(this->x, this->y), size).adjusted(-1, -1, 1, 1);
+    };
 private:
     const QStaticText text;
     int x;
     int y;
     QColor color;
     int fontSize;
+    QRectF bounds;
 };
 
 class OverlayPath : public OverlayItem {
@@ -44,6 +60,7 @@ public:
     }
     ~OverlayPath() {}
     virtual void render(QPainter *painter);
+    virtual QRectF boundingRect() const { return this->path.boundingRect().adjusted(-1, -1, 1, 1); };
 private:
     QPainterPath path;
     QColor borderColor;
@@ -59,6 +76,7 @@ public:
     }
     ~OverlayImage() {}
     virtual void render(QPainter *painter);
+    virtual QRectF boundingRect() const { return QRectF(this->x, this->y, this->image.width(), this->image.height()); };
 private:
     int x;
     int y;
@@ -101,7 +119,7 @@ public:
     void clearClippingRect();
     void setPosition(int x, int y);
     void move(int deltaX, int deltaY);
-    void renderItems(QPainter *painter);
+    void renderItems(QPainter *painter, const QRectF &exposedRect);
     QList<OverlayItem*> getItems();
     void clearItems();
     void addText(const QString text, int x, int y, QString colorStr, int fontSize);
@@ -112,7 +130,28 @@ public:
 private:
     void clampAngle();
     QColor getColor(QString colorStr);
+    void addItem(OverlayItem *item);
+    void invalidateItems();
+    void buildItemIndex();
+    QVector<int> getItemsInRect(const QRectF &rect);
+    void renderCache(QPainter *painter, qreal scale);
     QList<OverlayItem*> items;
+
+    // Items are indexed by the grid cells (in the overlay's coordinates) that their bounds cover,
+    // so that repainting a small area only renders the items within it.
+    QVector<QRectF> itemBounds;
+    QRectF allItemsBounds;
+    QHash<quint64, QVector<int>> itemIndex;
+    QVector<int> unindexedItems;
+    bool itemIndexValid = false;
+    QFont font; // The font that text items were measured with
+
+    // Overlays whose items haven't changed since they were last rendered are drawn from a cached image.
+    QPixmap cache;
+    qreal cacheScale = 0;
+    bool cacheValid = false;
+    int unchangedRenders = 0;
+
     int x;
     int y;
     int angle;
@@ -94,7 +94,7 @@ private:
     bool buildConfigDialog();
     poryjson::Json configRegionMapDialog();
     poryjson::Json buildDefaultJson();
-    bool verifyConfig(poryjson::Json cfg);
+    bool verifyConfig(const poryjson::Json &cfg);
 
     bool modified();
 
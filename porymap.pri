@@ -0,0 +1,235 @@
+#-------------------------------------------------
+#
+# The sources shared by porymap and its benchmarks (see benchmarks/benchmarks.pro).
+#
+#-------------------------------------------------
+
+QT       += core gui qml concurrent
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+QMAKE_CXXFLAGS += -std=c++17 -Wall
+
+# Used to read the peak memory usage for profiling
+win32: LIBS += -lpsapi
+
+SOURCES += $$PWD/src/core/block.cpp \
+    $$PWD/src/core/bitpacker.cpp \
+    $$PWD/src/core/blockdata.cpp \
+    $$PWD/src/core/constantlistmodel.cpp \
+    $$PWD/src/core/events.cpp \
+    $$PWD/src/core/fileutil.cpp \
+    $$PWD/src/core/heallocation.cpp \
+    $$PWD/src/core/imageexport.cpp \
+    $$PWD/src/core/map.cpp \
+    $$PWD/src/core/mapprefetcher.cpp \
+    $$PWD/src/core/maplayout.cpp \
+    $$PWD/src/core/mapparser.cpp \
+    $$PWD/src/core/metatile.cpp \
+    $$PWD/src/core/metatileparser.cpp \
+    $$PWD/src/core/paletteutil.cpp \
+    $$PWD/src/core/parseutil.cpp \
+    $$PWD/src/core/profiling.cpp \
+    $$PWD/src/core/tile.cpp \
+    $$PWD/src/core/tileset.cpp \
+    $$PWD/src/core/regionmap.cpp \
+    $$PWD/src/core/wildmoninfo.cpp \
+    $$PWD/src/core/editcommands.cpp \
+    $$PWD/src/lib/fex/lexer.cpp \
+    $$PWD/src/lib/fex/parser.cpp \
+    $$PWD/src/lib/fex/parser_util.cpp \
+    $$PWD/src/lib/orderedjson.cpp \
+    $$PWD/src/core/regionmapeditcommands.cpp \
+    $$PWD/src/scriptapi/apimap.cpp \
+    $$PWD/src/scriptapi/apioverlay.cpp \
+    $$PWD/src/scriptapi/apiutility.cpp \
+    $$PWD/src/scriptapi/scripting.cpp \
+    $$PWD/src/ui/aboutporymap.cpp \
+    $$PWD/src/ui/customscriptseditor.cpp \
+    $$PWD/src/ui/customscriptslistitem.cpp \
+    $$PWD/src/ui/draggablepixmapitem.cpp \
+    $$PWD/src/ui/bordermetatilespixmapitem.cpp \
+    $$PWD/src/ui/collisionpixmapitem.cpp \
+    $$PWD/src/ui/connectionpixmapitem.cpp \
+    $$PWD/src/ui/currentselectedmetatilespixmapitem.cpp \
+    $$PWD/src/ui/overlay.cpp \
+    $$PWD/src/ui/prefab.cpp \
+    $$PWD/src/ui/projectsettingseditor.cpp \
+    $$PWD/src/ui/regionmaplayoutpixmapitem.cpp \
+    $$PWD/src/ui/regionmapentriespixmapitem.cpp \
+    $$PWD/src/ui/cursortilerect.cpp \
+    $$PWD/src/ui/customattributestable.cpp \
+    $$PWD/src/ui/eventframes.cpp \
+    $$PWD/src/ui/maplistmodel.cpp \
+    $$PWD/src/ui/graphicsview.cpp \
+    $$PWD/src/ui/imageproviders.cpp \
+    $$PWD/src/ui/mappixmapitem.cpp \
+    $$PWD/src/ui/prefabcreationdialog.cpp \
+    $$PWD/src/ui/regionmappixmapitem.cpp \
+    $$PWD/src/ui/citymappixmapitem.cpp \
+    $$PWD/src/ui/mapsceneeventfilter.cpp \
+    $$PWD/src/ui/metatilelayersitem.cpp \
+    $$PWD/src/ui/metatileselector.cpp \
+    $$PWD/src/ui/movablerect.cpp \
+    $$PWD/src/ui/movementpermissionsselector.cpp \
+    $$PWD/src/ui/neweventtoolbutton.cpp \
+    $$PWD/src/ui/noscrollcombobox.cpp \
+    $$PWD/src/ui/noscrollspinbox.cpp \
+    $$PWD/src/ui/montabwidget.cpp \
+    $$PWD/src/ui/encountertablemodel.cpp \
+    $$PWD/src/ui/encountertabledelegates.cpp \
+    $$PWD/src/ui/paletteeditor.cpp \
+    $$PWD/src/ui/selectablepixmapitem.cpp \
+    $$PWD/src/ui/tileseteditor.cpp \
+    $$PWD/src/ui/tileseteditormetatileselector.cpp \
+    $$PWD/src/ui/tileseteditortileselector.cpp \
+    $$PWD/src/ui/tilemaptileselector.cpp \
+    $$PWD/src/ui/regionmapeditor.cpp \
+    $$PWD/src/ui/newmappopup.cpp \
+    $$PWD/src/ui/mapimageexporter.cpp \
+    $$PWD/src/ui/newtilesetdialog.cpp \
+    $$PWD/src/ui/flowlayout.cpp \
+    $$PWD/src/ui/mapruler.cpp \
+    $$PWD/src/ui/shortcut.cpp \
+    $$PWD/src/ui/shortcutseditor.cpp \
+    $$PWD/src/ui/multikeyedit.cpp \
+    $$PWD/src/ui/prefabframe.cpp \
+    $$PWD/src/ui/preferenceeditor.cpp \
+    $$PWD/src/ui/regionmappropertiesdialog.cpp \
+    $$PWD/src/ui/colorpicker.cpp \
+    $$PWD/src/config.cpp \
+    $$PWD/src/editor.cpp \
+    $$PWD/src/mainwindow.cpp \
+    $$PWD/src/project.cpp \
+    $$PWD/src/settings.cpp \
+    $$PWD/src/log.cpp \
+    $$PWD/src/ui/uintspinbox.cpp
+
+HEADERS  += $$PWD/include/core/block.h \
+    $$PWD/include/core/bitpacker.h \
+    $$PWD/include/core/blockdata.h \
+    $$PWD/include/core/constantlistmodel.h \
+    $$PWD/include/core/events.h \
+    $$PWD/include/core/fileutil.h \
+    $$PWD/include/core/heallocation.h \
+    $$PWD/include/core/history.h \
+    $$PWD/include/core/imageexport.h \
+    $$PWD/include/core/map.h \
+    $$PWD/include/core/mapprefetcher.h \
+    $$PWD/include/core/mapconnection.h \
+    $$PWD/include/core/maplayout.h \
+    $$PWD/include/core/mapparser.h \
+    $$PWD/include/core/metatile.h \
+    $$PWD/include/core/metatileparser.h \
+    $$PWD/include/core/paletteutil.h \
+    $$PWD/include/core/parseutil.h \
+    $$PWD/include/core/profiling.h \
+    $$PWD/include/core/tile.h \
+    $$PWD/include/core/tileset.h \
+    $$PWD/include/core/regionmap.h \
+    $$PWD/include/core/wildmoninfo.h \
+    $$PWD/include/core/editcommands.h \
+    $$PWD/include/core/regionmapeditcommands.h \
+    $$PWD/include/lib/fex/array.h \
+    $$PWD/include/lib/fex/array_value.h \
+    $$PWD/include/lib/fex/define_statement.h \
+    $$PWD/include/lib/fex/lexer.h \
+    $$PWD/include/lib/fex/parser.h \
+    $$PWD/include/lib/fex/parser_util.h \
+    $$PWD/include/lib/orderedmap.h \
+    $$PWD/include/lib/orderedjson.h \
+    $$PWD/include/ui/aboutporymap.h \
+    $$PWD/include/ui/customscriptseditor.h \
+    $$PWD/include/ui/customscriptslistitem.h \
+    $$PWD/include/ui/draggablepixmapitem.h \
+    $$PWD/include/ui/bordermetatilespixmapitem.h \
+    $$PWD/include/ui/collisionpixmapitem.h \
+    $$PWD/include/ui/connectionpixmapitem.h \
+    $$PWD/include/ui/currentselectedmetatilespixmapitem.h \
+    $$PWD/include/ui/prefabframe.h \
+    $$PWD/include/ui/projectsettingseditor.h \
+    $$PWD/include/ui/regionmaplayoutpixmapitem.h \
+    $$PWD/include/ui/regionmapentriespixmapitem.h \
+    $$PWD/include/ui/cursortilerect.h \
+    $$PWD/include/ui/customattributestable.h \
+    $$PWD/include/ui/eventframes.h \
+    $$PWD/include/ui/maplistmodel.h \
+    $$PWD/include/ui/graphicsview.h \
+    $$PWD/include/ui/imageproviders.h \
+    $$PWD/include/ui/mappixmapitem.h \
+    $$PWD/include/ui/mapview.h \
+    $$PWD/include/ui/prefabcreationdialog.h \
+    $$PWD/include/ui/regionmappixmapitem.h \
+    $$PWD/include/ui/citymappixmapitem.h \
+    $$PWD/include/ui/mapsceneeventfilter.h \
+    $$PWD/include/ui/metatilelayersitem.h \
+    $$PWD/include/ui/metatileselector.h \
+    $$PWD/include/ui/movablerect.h \
+    $$PWD/include/ui/movementpermissionsselector.h \
+    $$PWD/include/ui/neweventtoolbutton.h \
+    $$PWD/include/ui/noscrollcombobox.h \
+    $$PWD/include/ui/noscrollspinbox.h \
+    $$PWD/include/ui/montabwidget.h \
+    $$PWD/include/ui/encountertablemodel.h \
+    $$PWD/include/ui/encountertabledelegates.h \
+    $$PWD/include/ui/adjustingstackedwidget.h \
+    $$PWD/include/ui/paletteeditor.h \
+    $$PWD/include/ui/selectablepixmapitem.h \
+    $$PWD/include/ui/tileseteditor.h \
+    $$PWD/include/ui/tileseteditormetatileselector.h \
+    $$PWD/include/ui/tileseteditortileselector.h \
+    $$PWD/include/ui/tilemaptileselector.h \
+    $$PWD/include/ui/regionmapeditor.h \
+    $$PWD/include/ui/newmappopup.h \
+    $$PWD/include/ui/mapimageexporter.h \
+    $$PWD/include/ui/newtilesetdialog.h \
+    $$PWD/include/ui/overlay.h \
+    $$PWD/include/ui/flowlayout.h \
+    $$PWD/include/ui/mapruler.h \
+    $$PWD/include/ui/shortcut.h \
+    $$PWD/include/ui/shortcutseditor.h \
+    $$PWD/include/ui/multikeyedit.h \
+    $$PWD/include/ui/prefab.h \
+    $$PWD/include/ui/preferenceeditor.h \
+    $$PWD/include/ui/regionmappropertiesdialog.h \
+    $$PWD/include/ui/colorpicker.h \
+    $$PWD/include/config.h \
+    $$PWD/include/editor.h \
+    $$PWD/include/mainwindow.h \
+    $$PWD/include/project.h \
+    $$PWD/include/scripting.h \
+    $$PWD/include/scriptutility.h \
+    $$PWD/include/settings.h \
+    $$PWD/include/log.h \
+    $$PWD/include/ui/uintspinbox.h
+
+FORMS    += $$PWD/forms/mainwindow.ui \
+    $$PWD/forms/prefabcreationdialog.ui \
+    $$PWD/forms/prefabframe.ui \
+    $$PWD/forms/tileseteditor.ui \
+    $$PWD/forms/paletteeditor.ui \
+    $$PWD/forms/regionmapeditor.ui \
+    $$PWD/forms/newmappopup.ui \
+    $$PWD/forms/aboutporymap.ui \
+    $$PWD/forms/newtilesetdialog.ui \
+    $$PWD/forms/mapimageexporter.ui \
+    $$PWD/forms/shortcutseditor.ui \
+    $$PWD/forms/preferenceeditor.ui \
+    $$PWD/forms/regionmappropertiesdialog.ui \
+    $$PWD/forms/colorpicker.ui \
+    $$PWD/forms/projectsettingseditor.ui \
+    $$PWD/forms/customscriptseditor.ui \
+    $$PWD/forms/customscriptslistitem.ui
+
+RESOURCES += \
+    $$PWD/resources/images.qrc \
+    $$PWD/resources/themes.qrc \
+    $$PWD/resources/text.qrc
+
+INCLUDEPATH += $$PWD/include
+INCLUDEPATH += $$PWD/include/core
+INCLUDEPATH += $$PWD/include/ui
+INCLUDEPATH += $$PWD/include/lib
+INCLUDEPATH += $$PWD/forms
+
+include($$PWD/src/vendor/QtGifImage/gifimage/qtgifimage.pri)
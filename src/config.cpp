@@ -304,6 +304,18 @@ const QMap<QString, MapSortOrder> mapSortOrderReverseMap = {
     {"area", MapSortOrder::Area},
 };
 
+const QMap<LogType, QString> logLevelMap = {
+    {LogType::LOG_ERROR, "error"},
+    {LogType::LOG_WARN, "warn"},
+    {LogType::LOG_INFO, "info"},
+};
+
+const QMap<QString, LogType> logLevelReverseMap = {
+    {"error", LogType::LOG_ERROR},
+    {"warn", LogType::LOG_WARN},
+    {"info", LogType::LOG_INFO},
+};
+
 PorymapConfig porymapConfig;
 
 QString PorymapConfig::getConfigFilepath() {
@@ -407,6 +419,14 @@ void PorymapConfig::parseConfigKeyValue(QString key, QString value) {
         this->projectSettingsTab = getConfigInteger(key, value, 0);
     } else if (key == "warp_behavior_warning_disabled") {
         this->warpBehaviorWarningDisabled = getConfigBool(key, value);
+    } else if (key == "log_level") {
+        QString logLevel = value.toLower();
+        if (logLevelReverseMap.contains(logLevel)) {
+            this->logLevel = logLevelReverseMap.value(logLevel);
+        } else {
+            this->logLevel = LogType::LOG_INFO;
+            logWarn(QString("Invalid config value for log_level: '%1'. Must be 'error', 'warn', or 'info'.").arg(value));
+        }
     } else {
         logWarn(QString("Invalid config key found in config file %1: '%2'").arg(this->getConfigFilepath()).arg(key));
     }
@@ -453,6 +473,7 @@ QMap<QString, QString> PorymapConfig::getKeyValueMap() {
     map.insert("palette_editor_bit_depth", QString::number(this->paletteEditorBitDepth));
     map.insert("project_settings_tab", QString::number(this->projectSettingsTab));
     map.insert("warp_behavior_warning_disabled", QString::number(this->warpBehaviorWarningDisabled));
+    map.insert("log_level", logLevelMap.value(this->logLevel));
     
     return map;
 }
@@ -790,6 +811,10 @@ bool PorymapConfig::getWarpBehaviorWarningDisabled() {
     return this->warpBehaviorWarningDisabled;
 }
 
+LogType PorymapConfig::getLogLevel() {
+    return this->logLevel;
+}
+
 const QStringList ProjectConfig::versionStrings = {
     "pokeruby",
     "pokefirered",
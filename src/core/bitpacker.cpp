@@ -19,6 +19,12 @@ void BitPacker::setMask(uint32_t mask) {
 
     // For masks with only contiguous bits m_maxValue is equivalent to (m_mask >> n), where n is the number of trailing 0's in m_mask.
     m_maxValue = (m_setBits.length() >= 32) ? UINT_MAX : ((1 << m_setBits.length()) - 1);
+
+    // Record whether the mask bits are contiguous, so that packing and unpacking can be done with a single shift.
+    m_shift = 0;
+    for (uint32_t bits = m_mask; bits != 0 && !(bits & 1); bits >>= 1)
+        m_shift++;
+    m_contiguous = (m_mask == 0) || ((m_mask >> m_shift) == m_maxValue);
 }
 
 // Given an arbitrary value to set for this bitfield member, returns a (potentially truncated) value that can later be packed losslessly.
@@ -29,6 +35,9 @@ uint32_t BitPacker::clamp(uint32_t value) const {
 // Given packed data, returns the extracted value for the bitfield member.
 // For masks with only contiguous bits this is equivalent to ((data & m_mask) >> n), where n is the number of trailing 0's in m_mask.
 uint32_t BitPacker::unpack(uint32_t data) const {
+    if (m_contiguous)
+        return (data & m_mask) >> m_shift;
+
     uint32_t value = 0;
     data &= m_mask;
     for (int i = 0; i < m_setBits.length(); i++) {
@@ -41,6 +50,9 @@ uint32_t BitPacker::unpack(uint32_t data) const {
 // Given a value for the bitfield member, returns the value to OR together with the other members.
 // For masks with only contiguous bits this is equivalent to ((value << n) & m_mask), where n is the number of trailing 0's in m_mask.
 uint32_t BitPacker::pack(uint32_t value) const {
+    if (m_contiguous)
+        return (value << m_shift) & m_mask;
+
     uint32_t data = 0;
     for (int i = 0; i < m_setBits.length(); i++) {
         if (value == 0) return data;
@@ -27,19 +27,6 @@ Block::Block(uint16_t data) :
     m_elevation(bitsElevation.unpack(data))
 {  }
 
-Block::Block(const Block &other) :
-    m_metatileId(other.m_metatileId),
-    m_collision(other.m_collision),
-    m_elevation(other.m_elevation)
-{  }
-
-Block &Block::operator=(const Block &other) {
-    m_metatileId = other.m_metatileId;
-    m_collision = other.m_collision;
-    m_elevation = other.m_elevation;
-    return *this;
-}
-
 uint16_t Block::rawValue() const {
     return bitsMetatileId.pack(m_metatileId)
           | bitsCollision.pack(m_collision)
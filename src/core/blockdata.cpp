@@ -1,11 +1,50 @@
 #include "blockdata.h"
 
+#include <QtEndian>
+#include <cstring>
+
 QByteArray Blockdata::serialize() const {
-    QByteArray data;
-    for (const auto &block : *this) {
-        uint16_t word = block.rawValue();
-        data.append(static_cast<char>(word & 0xff));
-        data.append(static_cast<char>((word >> 8) & 0xff));
-    }
+    QByteArray data(this->size() * 2, Qt::Uninitialized);
+    uchar *out = reinterpret_cast<uchar *>(data.data());
+    for (int i = 0; i < this->size(); i++)
+        qToLittleEndian<quint16>(this->at(i).rawValue(), out + i * 2);
     return data;
 }
+
+// Reads blockdata from its on-disk format (one little-endian 16-bit word per block).
+// A trailing odd byte is ignored.
+Blockdata Blockdata::deserialize(const QByteArray &data) {
+    Blockdata blockdata;
+    const int numBlocks = data.size() / 2;
+    blockdata.resize(numBlocks);
+
+    const uchar *in = reinterpret_cast<const uchar *>(data.constData());
+    Block *blocks = blockdata.data();
+    for (int i = 0; i < numBlocks; i++)
+        blocks[i] = Block(qFromLittleEndian<quint16>(in + i * 2));
+    return blockdata;
+}
+
+QVector<uint16_t> Blockdata::metatileIdPlane() const {
+    QVector<uint16_t> plane(this->size());
+    uint16_t *out = plane.data();
+    for (int i = 0; i < this->size(); i++)
+        out[i] = this->at(i).metatileId();
+    return plane;
+}
+
+QVector<uint32_t> Blockdata::collisionPlane() const {
+    QVector<uint32_t> plane(this->size());
+    uint32_t *out = plane.data();
+    for (int i = 0; i < this->size(); i++)
+        out[i] = collisionPlaneValue(this->at(i));
+    return plane;
+}
+
+bool Blockdata::operator==(const Blockdata &other) const {
+    if (this->size() != other.size())
+        return false;
+    if (this->constData() == other.constData())
+        return true; // Implicitly shared
+    return std::memcmp(this->constData(), other.constData(), this->size() * sizeof(Block)) == 0;
+}
@@ -0,0 +1,117 @@
+#include "constantlistmodel.h"
+
+#include <algorithm>
+#include <numeric>
+
+ConstantListModel::ConstantListModel(const QStringList &names, const QVariantList &values, QObject *parent)
+    : QAbstractListModel(parent), m_names(names), m_values(values)
+{
+    this->m_rows.reserve(names.length());
+    for (int i = names.length() - 1; i >= 0; i--)
+        this->m_rows.insert(names.at(i), i);
+
+    QStringList lowerNames;
+    lowerNames.reserve(names.length());
+    for (const QString &name : names)
+        lowerNames.append(name.toLower());
+
+    this->m_sortedRows.resize(names.length());
+    std::iota(this->m_sortedRows.begin(), this->m_sortedRows.end(), 0);
+    std::stable_sort(this->m_sortedRows.begin(), this->m_sortedRows.end(), [&lowerNames](int a, int b) {
+        return lowerNames.at(a) < lowerNames.at(b);
+    });
+
+    this->m_sortedNames.reserve(names.length());
+    for (int row : this->m_sortedRows)
+        this->m_sortedNames.append(lowerNames.at(row));
+}
+
+int ConstantListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : this->m_names.length();
+}
+
+QVariant ConstantListModel::data(const QModelIndex &index, int role) const {
+    int row = index.row();
+    if (!index.isValid() || row < 0 || row >= this->m_names.length())
+        return QVariant();
+
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
+        return this->m_names.at(row);
+    if (role == Qt::UserRole)
+        return this->m_values.value(row);
+    return QVariant();
+}
+
+// Returns the rows of every name starting with the given text (ignoring case), in order.
+QList<int> ConstantListModel::rowsWithPrefix(const QString &prefix) const {
+    const QString lowerPrefix = prefix.toLower();
+    auto it = std::lower_bound(this->m_sortedNames.begin(), this->m_sortedNames.end(), lowerPrefix);
+    QList<int> rows;
+    for (; it != this->m_sortedNames.end() && it->startsWith(lowerPrefix); it++)
+        rows.append(this->m_sortedRows.at(it - this->m_sortedNames.begin()));
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+void ConstantListModel::addUser(QObject *user) {
+    if (!user || this->m_users.contains(user))
+        return;
+    this->m_users.insert(user, connect(user, &QObject::destroyed, this, [this, user] { this->removeUser(user); }));
+}
+
+void ConstantListModel::removeUser(QObject *user) {
+    auto it = this->m_users.find(user);
+    if (it == this->m_users.end())
+        return;
+    disconnect(it.value());
+    this->m_users.erase(it);
+    this->deleteIfUnused();
+}
+
+void ConstantListModel::setSuperseded() {
+    this->m_superseded = true;
+    this->deleteIfUnused();
+}
+
+void ConstantListModel::deleteIfUnused() {
+    if (this->m_superseded && this->m_users.isEmpty())
+        this->deleteLater();
+}
+
+// Exact and prefix searches for names (e.g. QComboBox::findText, or typing to select an item)
+// are answered from the indexes. Anything else is left to the default search.
+QModelIndexList ConstantListModel::match(const QModelIndex &start, int role, const QVariant &value, int hits, Qt::MatchFlags flags) const {
+    if (role != Qt::DisplayRole && role != Qt::EditRole)
+        return QAbstractListModel::match(start, role, value, hits, flags);
+
+    const int matchType = static_cast<int>(flags) & 0x0F;
+    const bool caseSensitive = flags.testFlag(Qt::MatchCaseSensitive);
+    const bool wrap = flags.testFlag(Qt::MatchWrap);
+    const QString text = value.toString();
+    QList<int> rows;
+    if ((matchType == Qt::MatchExactly || matchType == Qt::MatchFixedString) && caseSensitive) {
+        // Only the first occurrence of a name is indexed, search normally if more than one is wanted.
+        if (hits != 1)
+            return QAbstractListModel::match(start, role, value, hits, flags);
+        int row = this->indexOf(text);
+        if (row >= 0 && (row >= start.row() || wrap))
+            rows.append(row);
+    } else if (matchType == Qt::MatchStartsWith && !caseSensitive) {
+        rows = this->rowsWithPrefix(text);
+        // Start searching from the given row, wrapping around to the beginning if requested.
+        auto split = std::lower_bound(rows.begin(), rows.end(), start.row());
+        QList<int> wrapped = wrap ? QList<int>(rows.begin(), split) : QList<int>();
+        rows.erase(rows.begin(), split);
+        rows.append(wrapped);
+    } else {
+        return QAbstractListModel::match(start, role, value, hits, flags);
+    }
+
+    QModelIndexList result;
+    for (int row : rows) {
+        if (hits != -1 && result.length() >= hits)
+            break;
+        result.append(this->index(row));
+    }
+    return result;
+}
@@ -6,6 +6,51 @@
 
 QMap<Event::Group, const QPixmap*> Event::icons;
 
+QPixmap EventGraphics::getFrame(int frame, bool hFlip) {
+    // Inanimate graphics only have one frame
+    if (this->inanimate) {
+        frame = 0;
+        hFlip = false;
+    }
+
+    const QPair<int, bool> key(frame, hFlip);
+    auto it = this->frames.constFind(key);
+    if (it != this->frames.constEnd())
+        return it.value();
+
+    int x = 0;
+    int y = 0;
+
+    // Get frame's position in spritesheet.
+    // Assume horizontal layout. If position would exceed sheet width, try vertical layout.
+    if ((frame + 1) * this->spriteWidth <= this->spritesheet.width()) {
+        x = frame * this->spriteWidth;
+    } else if ((frame + 1) * this->spriteHeight <= this->spritesheet.height()) {
+        y = frame * this->spriteHeight;
+    }
+
+    QImage img = this->spritesheet.copy(x, y, this->spriteWidth, this->spriteHeight);
+
+    // Right-facing sprite is just the left-facing sprite mirrored
+    if (hFlip) {
+        img = img.transformed(QTransform().scale(-1, 1));
+    }
+
+    // Set first palette color fully transparent.
+    img.setColor(0, qRgba(0, 0, 0, 0));
+    QPixmap pixmap = QPixmap::fromImage(img);
+    this->frames.insert(key, pixmap);
+    return pixmap;
+}
+
+// Frees the decoded spritesheet and its frames. Events keep the pixmaps they already have,
+// and the spritesheet will be decoded again the next time it's needed.
+void EventGraphics::unload() {
+    this->spritesheet = QImage();
+    this->frames.clear();
+    this->loaded = false;
+}
+
 Event::~Event() {
     if (this->eventFrame)
         this->eventFrame->deleteLater();
@@ -277,7 +322,7 @@ void ObjectEvent::loadPixmap(Project *project) {
             eventGfx = project->eventGraphicsMap.value(project->gfxDefines.key(altGfx, "NULL"), nullptr);
         }
     }
-    if (!eventGfx || eventGfx->spritesheet.isNull()) {
+    if (!project->loadEventGraphics(eventGfx)) {
         // No sprite associated with this gfx constant.
         // Use default sprite instead.
         Event::loadPixmap(project);
@@ -292,31 +337,7 @@ void ObjectEvent::loadPixmap(Project *project) {
 
 void ObjectEvent::setPixmapFromSpritesheet(EventGraphics * gfx)
 {
-    QImage img;
-    if (gfx->inanimate) {
-        img = gfx->spritesheet.copy(0, 0, gfx->spriteWidth, gfx->spriteHeight);
-    } else {
-        int x = 0;
-        int y = 0;
-
-        // Get frame's position in spritesheet.
-        // Assume horizontal layout. If position would exceed sheet width, try vertical layout.
-        if ((this->frame + 1) * gfx->spriteWidth <= gfx->spritesheet.width()) {
-            x = this->frame * gfx->spriteWidth;
-        } else if ((this->frame + 1) * gfx->spriteHeight <= gfx->spritesheet.height()) {
-            y = this->frame * gfx->spriteHeight;
-        }
-
-        img = gfx->spritesheet.copy(x, y, gfx->spriteWidth, gfx->spriteHeight);
-
-        // Right-facing sprite is just the left-facing sprite mirrored
-        if (this->hFlip) {
-            img = img.transformed(QTransform().scale(-1, 1));
-        }
-    }
-    // Set first palette color fully transparent.
-    img.setColor(0, qRgba(0, 0, 0, 0));
-    pixmap = QPixmap::fromImage(img);
+    pixmap = gfx->getFrame(this->frame, this->hFlip);
     this->spriteWidth = gfx->spriteWidth;
     this->spriteHeight = gfx->spriteHeight;
     this->usingSprite = true;
@@ -441,7 +462,7 @@ void CloneObjectEvent::loadPixmap(Project *project) {
     }
 
     EventGraphics *eventGfx = project->eventGraphicsMap.value(gfx, nullptr);
-    if (!eventGfx || eventGfx->spritesheet.isNull()) {
+    if (!project->loadEventGraphics(eventGfx)) {
         // No sprite associated with this gfx constant.
         // Use default sprite instead.
         Event::loadPixmap(project);
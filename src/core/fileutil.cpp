@@ -0,0 +1,66 @@
+#include "fileutil.h"
+#include "profiling.h"
+#include "log.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QSaveFile>
+
+// Returns true if the file at the given path exists and contains exactly the given data.
+bool FileUtil::contentsEqual(const QString &filepath, const QByteArray &data) {
+    QFile file(filepath);
+    if (!file.exists() || file.size() != data.size())
+        return false;
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    return file.readAll() == data;
+}
+
+// Returns a hash of the file's contents, or an empty QByteArray if the file can't be read.
+QByteArray FileUtil::hash(const QString &filepath) {
+    QFile file(filepath);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(&file);
+    return hash.result();
+}
+
+// Overwrites the file in place, for locations where a temporary file can't be created.
+static bool writeDirectly(const QString &filepath, const QByteArray &data, QString *errorString) {
+    QFile file(filepath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// Writes the data to the given file, unless the file already has identical contents.
+// Leaving unchanged files untouched preserves their modification times, so saving
+// doesn't cause the project's build system to rebuild everything.
+// The data is written to a temporary file which then replaces the original, so if
+// writing fails partway through (or Porymap crashes) the original file is left intact.
+// Returns false if the file needed to be written but couldn't be.
+bool FileUtil::writeIfChanged(const QString &filepath, const QByteArray &data, QString *errorString) {
+    PROFILE_SCOPE("FileUtil::writeIfChanged");
+    const bool unchanged = contentsEqual(filepath, data);
+    Profiling::addCacheResult("FileUtil::writeIfChanged", unchanged);
+    if (unchanged)
+        return true;
+    Profiling::addBytes("FileUtil::writeIfChanged", data.size());
+
+    QSaveFile file(filepath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        // Some locations don't allow creating the temporary file (e.g. files in a read-only directory),
+        // in which case we fall back to writing the file directly, without the guarantee above.
+        logWarn(QString("Unable to write '%1' safely (%2), writing it directly instead").arg(filepath).arg(file.errorString()));
+        return writeDirectly(filepath, data, errorString);
+    }
+    // If the write fails the temporary file is discarded without being committed.
+    if (file.write(data) != data.size() || !file.commit()) {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -2,6 +2,7 @@
 #include "map.h"
 #include "imageproviders.h"
 #include "scripting.h"
+#include "profiling.h"
 
 #include "editcommands.h"
 
@@ -62,22 +63,33 @@ int Map::getBorderHeight() {
     return layout->getBorderHeight();
 }
 
-bool Map::mapBlockChanged(int i, const Blockdata &cache) {
+// The render caches only hold the data that affects the corresponding image,
+// e.g. changing a block's collision doesn't require redrawing its metatile.
+bool Map::mapBlockChanged(int i, const QVector<uint16_t> &cache) {
     if (cache.length() <= i)
         return true;
     if (layout->blockdata.length() <= i)
         return true;
 
-    return layout->blockdata.at(i) != cache.at(i);
+    return layout->blockdata.at(i).metatileId() != cache.at(i);
 }
 
-bool Map::borderBlockChanged(int i, const Blockdata &cache) {
+bool Map::collisionBlockChanged(int i, const QVector<uint32_t> &cache) {
+    if (cache.length() <= i)
+        return true;
+    if (layout->blockdata.length() <= i)
+        return true;
+
+    return Blockdata::collisionPlaneValue(layout->blockdata.at(i)) != cache.at(i);
+}
+
+bool Map::borderBlockChanged(int i, const QVector<uint16_t> &cache) {
     if (cache.length() <= i)
         return true;
     if (layout->border.length() <= i)
         return true;
 
-    return layout->border.at(i) != cache.at(i);
+    return layout->border.at(i).metatileId() != cache.at(i);
 }
 
 void Map::clearBorderCache() {
@@ -85,24 +97,19 @@ void Map::clearBorderCache() {
 }
 
 void Map::cacheBorder() {
-    layout->cached_border.clear();
-    for (const auto &block : layout->border)
-        layout->cached_border.append(block);
+    layout->cached_border = layout->border.metatileIdPlane();
 }
 
 void Map::cacheBlockdata() {
-    layout->cached_blockdata.clear();
-    for (const auto &block : layout->blockdata)
-        layout->cached_blockdata.append(block);
+    layout->cached_blockdata = layout->blockdata.metatileIdPlane();
 }
 
 void Map::cacheCollision() {
-    layout->cached_collision.clear();
-    for (const auto &block : layout->blockdata)
-        layout->cached_collision.append(block);
+    layout->cached_collision = layout->blockdata.collisionPlane();
 }
 
 QPixmap Map::renderCollision(bool ignoreCache) {
+    PROFILE_SCOPE("Map::renderCollision");
     bool changed_any = false;
     int width_ = getWidth();
     int height_ = getHeight();
@@ -114,9 +121,13 @@ QPixmap Map::renderCollision(bool ignoreCache) {
         collision_pixmap = collision_pixmap.fromImage(collision_image);
         return collision_pixmap;
     }
+    if (ignoreCache && takePrerenderedCollisionImage()) {
+        collision_pixmap = collision_pixmap.fromImage(collision_image);
+        return collision_pixmap;
+    }
     QPainter painter(&collision_image);
     for (int i = 0; i < layout->blockdata.length(); i++) {
-        if (!ignoreCache && !mapBlockChanged(i, layout->cached_collision)) {
+        if (!ignoreCache && !collisionBlockChanged(i, layout->cached_collision)) {
             continue;
         }
         changed_any = true;
@@ -136,6 +147,7 @@ QPixmap Map::renderCollision(bool ignoreCache) {
 }
 
 QPixmap Map::render(bool ignoreCache, MapLayout * fromLayout, QRect bounds) {
+    PROFILE_SCOPE("Map::render");
     bool changed_any = false;
     int width_ = getWidth();
     int height_ = getHeight();
@@ -147,6 +159,10 @@ QPixmap Map::render(bool ignoreCache, MapLayout * fromLayout, QRect bounds) {
         pixmap = pixmap.fromImage(image);
         return pixmap;
     }
+    if (ignoreCache && !fromLayout && !bounds.isValid() && takePrerenderedImage()) {
+        pixmap = pixmap.fromImage(image);
+        return pixmap;
+    }
 
     QPainter painter(&image);
     for (int i = 0; i < layout->blockdata.length(); i++) {
@@ -180,6 +196,7 @@ QPixmap Map::render(bool ignoreCache, MapLayout * fromLayout, QRect bounds) {
 }
 
 QPixmap Map::renderBorder(bool ignoreCache) {
+    PROFILE_SCOPE("Map::renderBorder");
     bool changed_any = false, border_resized = false;
     int width_ = getBorderWidth();
     int height_ = getBorderHeight();
@@ -217,7 +234,11 @@ QPixmap Map::renderBorder(bool ignoreCache) {
     return layout->border_pixmap;
 }
 
-QPixmap Map::renderConnection(MapConnection connection, MapLayout * fromLayout) {
+// Renders the part of this map that's visible from a map connected in the given direction,
+// using the tilesets of the connected map's layout. Only the strip itself is rendered, and
+// the result is reused until the strip's metatiles, the tilesets or the layer settings change.
+QPixmap Map::renderConnection(MapConnection connection, MapLayout * fromLayout, bool ignoreCache) {
+    PROFILE_SCOPE("Map::renderConnection");
     int x, y, w, h;
     if (connection.direction == "up") {
         x = 0;
@@ -247,9 +268,120 @@ QPixmap Map::renderConnection(MapConnection connection, MapLayout * fromLayout)
         h = getHeight();
     }
 
-    render(true, fromLayout, QRect(x, y, w, h));
-    QImage connection_image = image.copy(x * 16, y * 16, w * 16, h * 16);
-    return QPixmap::fromImage(connection_image);
+    const QRect bounds(x, y, w, h);
+    const QRect mapBounds = bounds.intersected(QRect(0, 0, getWidth(), getHeight()));
+    Tileset *primaryTileset = fromLayout ? fromLayout->tileset_primary : layout->tileset_primary;
+    Tileset *secondaryTileset = fromLayout ? fromLayout->tileset_secondary : layout->tileset_secondary;
+
+    QVector<uint16_t> metatileIds;
+    metatileIds.reserve(mapBounds.width() * mapBounds.height());
+    for (int j = mapBounds.top(); j <= mapBounds.bottom(); j++)
+    for (int i = mapBounds.left(); i <= mapBounds.right(); i++)
+        metatileIds.append(layout->blockdata.value(j * getWidth() + i).metatileId());
+
+    ConnectionStrip &strip = this->connectionStrips[connection.direction];
+    const bool cached = !ignoreCache
+                     && !strip.pixmap.isNull()
+                     && strip.bounds == bounds
+                     && strip.primaryTileset == primaryTileset
+                     && strip.secondaryTileset == secondaryTileset
+                     && strip.layerOrder == metatileLayerOrder
+                     && strip.layerOpacity == metatileLayerOpacity
+                     && strip.metatileIds == metatileIds;
+    Profiling::addCacheResult("Map::renderConnection", cached);
+    if (cached) {
+        return strip.pixmap;
+    }
+
+    // Areas of the strip beyond the edges of a small map are left transparent.
+    QImage connection_image(w * 16, h * 16, QImage::Format_RGBA8888);
+    connection_image.fill(Qt::transparent);
+
+    // Strips are often made of only a few different metatiles, so each is only rendered once.
+    QHash<uint16_t, QImage> metatileImages;
+    QPainter painter(&connection_image);
+    int index = 0;
+    for (int j = mapBounds.top(); j <= mapBounds.bottom(); j++)
+    for (int i = mapBounds.left(); i <= mapBounds.right(); i++) {
+        uint16_t metatileId = metatileIds.at(index++);
+        auto it = metatileImages.find(metatileId);
+        if (it == metatileImages.end()) {
+            it = metatileImages.insert(metatileId, getMetatileImage(
+                metatileId,
+                primaryTileset,
+                secondaryTileset,
+                metatileLayerOrder,
+                metatileLayerOpacity
+            ));
+        }
+        painter.drawImage(QPoint((i - x) * 16, (j - y) * 16), it.value());
+    }
+    painter.end();
+
+    strip.bounds = bounds;
+    strip.metatileIds = metatileIds;
+    strip.primaryTileset = primaryTileset;
+    strip.secondaryTileset = secondaryTileset;
+    strip.layerOrder = metatileLayerOrder;
+    strip.layerOpacity = metatileLayerOpacity;
+    strip.pixmap = QPixmap::fromImage(connection_image);
+    return strip.pixmap;
+}
+
+// Called when the contents of the tilesets may have changed, which the connection strips can't detect themselves.
+void Map::clearConnectionCache() {
+    this->connectionStrips.clear();
+}
+
+// Prerendered images are only accepted if nothing has cleared them since the given revision was read,
+// which means they were rendered from tilesets that haven't changed since.
+bool Map::setPrerenderedImages(const PrerenderedImages &images, int revision) {
+    if (revision != this->prerenderRevision)
+        return false;
+    this->prerendered = images;
+    return true;
+}
+
+void Map::clearPrerenderedImages() {
+    this->prerendered = PrerenderedImages();
+    this->prerenderRevision++;
+}
+
+// Uses the prerendered map image if it's what render() would draw now. Either way it's only used once.
+bool Map::takePrerenderedImage() {
+    if (this->prerendered.image.isNull())
+        return false;
+
+    bool current = this->prerendered.image.size() == QSize(getWidth() * 16, getHeight() * 16)
+                && this->prerendered.primaryTileset == layout->tileset_primary
+                && this->prerendered.secondaryTileset == layout->tileset_secondary
+                && this->prerendered.layerOrder == metatileLayerOrder
+                && this->prerendered.layerOpacity == metatileLayerOpacity
+                && this->prerendered.metatileIds == layout->blockdata.metatileIdPlane();
+    Profiling::addCacheResult("Map::render (prerendered)", current);
+    if (current) {
+        image = this->prerendered.image;
+        layout->cached_blockdata = this->prerendered.metatileIds;
+    }
+    this->prerendered.image = QImage();
+    this->prerendered.metatileIds.clear();
+    return current;
+}
+
+bool Map::takePrerenderedCollisionImage() {
+    if (this->prerendered.collisionImage.isNull())
+        return false;
+
+    bool current = this->prerendered.collisionImage.size() == QSize(getWidth() * 16, getHeight() * 16)
+                && this->prerendered.collision == layout->blockdata.collisionPlane();
+    Profiling::addCacheResult("Map::renderCollision (prerendered)", current);
+    if (current) {
+        collision_image = this->prerendered.collisionImage;
+        layout->cached_collision = this->prerendered.collision;
+    }
+    this->prerendered.collisionImage = QImage();
+    this->prerendered.collision.clear();
+    return current;
 }
 
 void Map::setNewDimensionsBlockdata(int newWidth, int newHeight) {
@@ -440,16 +572,17 @@ void Map::floodFillCollisionElevation(int x, int y, uint16_t collision, uint16_t
 void Map::magicFillCollisionElevation(int initialX, int initialY, uint16_t collision, uint16_t elevation) {
     Block block;
     if (getBlock(initialX, initialY, &block) && (block.collision() != collision || block.elevation() != elevation)) {
-        uint old_coll = block.collision();
-        uint old_elev = block.elevation();
-
-        for (int y = 0; y < getHeight(); y++) {
-            for (int x = 0; x < getWidth(); x++) {
-                if (getBlock(x, y, &block) && block.collision() == old_coll && block.elevation() == old_elev) {
-                    block.setCollision(collision);
-                    block.setElevation(elevation);
-                    setBlock(x, y, block, true);
-                }
+        const uint32_t oldValue = Blockdata::collisionPlaneValue(block);
+        const int width = getWidth();
+        const int size = qMin(layout->blockdata.size(), width * getHeight());
+
+        // Scan the blockdata linearly rather than looking up each coordinate.
+        for (int i = 0; i < size; i++) {
+            block = layout->blockdata.at(i);
+            if (Blockdata::collisionPlaneValue(block) == oldValue) {
+                block.setCollision(collision);
+                block.setElevation(elevation);
+                setBlock(i % width, i / width, block, true);
             }
         }
     }
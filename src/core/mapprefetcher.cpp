@@ -0,0 +1,158 @@
+#include "mapprefetcher.h"
+#include "project.h"
+#include "map.h"
+#include "imageproviders.h"
+#include "log.h"
+#include "profiling.h"
+
+#include <QtConcurrent>
+#include <QFutureWatcher>
+#include <QPainter>
+
+// How long the user needs to stay on a map before prefetching starts, in milliseconds.
+static const int idleDelay = 500;
+
+// Prerendered images are kept until they're used or another map is opened, so only a few maps are prefetched at a time.
+static const int maxPrefetchedMaps = 8;
+
+// Draws the image of each cell of a map from the images of each distinct value.
+template <typename T>
+static QImage renderPlane(int width, int height, const QVector<T> &plane, const QHash<T, QImage> &images) {
+    QImage image(width * 16, height * 16, QImage::Format_RGBA8888);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    for (int i = 0; i < plane.length(); i++) {
+        painter.drawImage(QPoint((i % width) * 16, (i / width) * 16), images.value(plane.at(i)));
+    }
+    painter.end();
+    return image;
+}
+
+MapPrefetcher::MapPrefetcher(QObject *parent) : QObject(parent) {
+    this->timer.setSingleShot(true);
+    connect(&this->timer, &QTimer::timeout, this, &MapPrefetcher::prefetchNext);
+}
+
+// Starts prefetching the given maps once the user has been idle for a moment, replacing any earlier request.
+void MapPrefetcher::prefetch(Project *project, const QStringList &mapNames) {
+    this->cancel();
+    for (const QString &mapName : mapNames) {
+        if (this->queue.length() >= maxPrefetchedMaps)
+            break;
+        if (!mapName.isEmpty() && !this->queue.contains(mapName))
+            this->queue.append(mapName);
+    }
+
+    // Free the images of maps that are no longer likely to be opened.
+    if (this->project) {
+        for (const QString &mapName : this->prerenderedMaps) {
+            Map *map = this->project->mapCache.value(mapName);
+            if (map && !this->queue.contains(mapName))
+                map->clearPrerenderedImages();
+        }
+    }
+    this->prerenderedMaps.clear();
+    this->project = project;
+
+    if (!this->queue.isEmpty())
+        this->timer.start(idleDelay);
+}
+
+void MapPrefetcher::cancel() {
+    this->timer.stop();
+    this->queue.clear();
+    this->generation++;
+}
+
+// Prefetches one map at a time, so that the event loop can run in between.
+void MapPrefetcher::prefetchNext() {
+    while (!this->queue.isEmpty()) {
+        const QString mapName = this->queue.takeFirst();
+        if (!this->canPrefetch(mapName))
+            continue;
+
+        Map *map = this->project->loadMap(mapName);
+        if (!map) {
+            logWarn(QString("Failed to prefetch map '%1'").arg(mapName));
+            continue;
+        }
+        if (map->hasPrerenderedImages()) {
+            this->prerenderedMaps.append(mapName);
+        } else {
+            this->prerender(map);
+        }
+        break;
+    }
+    if (!this->queue.isEmpty())
+        this->timer.start(0);
+}
+
+bool MapPrefetcher::canPrefetch(const QString &mapName) const {
+    if (!this->project || !this->project->mapHeaders.contains(mapName))
+        return false;
+    if (this->project->mapCache.contains(mapName))
+        return true;
+
+    // Loading a map reloads its layout from disk, which would discard unsaved changes made through another map that shares it.
+    const QString layoutId = this->project->readMapLayoutId(mapName);
+    for (Map *map : this->project->mapCache) {
+        if (map->layoutId == layoutId && map->hasUnsavedChanges())
+            return false;
+    }
+    return true;
+}
+
+// The metatile and collision images are read on this thread, because the tilesets may change while the map is rendered.
+// Only composing them into the full images happens in the background.
+void MapPrefetcher::prerender(Map *map) {
+    PROFILE_SCOPE("MapPrefetcher::prerender");
+    MapLayout *layout = map->layout;
+    if (!layout || layout->blockdata.isEmpty())
+        return;
+    const int width = map->getWidth();
+    const int height = map->getHeight();
+    if (!width || !height || layout->blockdata.length() != width * height)
+        return;
+
+    Map::PrerenderedImages images;
+    images.metatileIds = layout->blockdata.metatileIdPlane();
+    images.collision = layout->blockdata.collisionPlane();
+    images.primaryTileset = layout->tileset_primary;
+    images.secondaryTileset = layout->tileset_secondary;
+    images.layerOrder = map->metatileLayerOrder;
+    images.layerOpacity = map->metatileLayerOpacity;
+
+    QHash<uint16_t, QImage> metatileImages;
+    QHash<uint32_t, QImage> collisionImages;
+    for (int i = 0; i < layout->blockdata.length(); i++) {
+        const uint16_t metatileId = images.metatileIds.at(i);
+        if (!metatileImages.contains(metatileId)) {
+            metatileImages.insert(metatileId, getMetatileImage(metatileId, images.primaryTileset, images.secondaryTileset,
+                                                               images.layerOrder, images.layerOpacity));
+        }
+        const uint32_t collision = images.collision.at(i);
+        if (!collisionImages.contains(collision)) {
+            collisionImages.insert(collision, getCollisionMetatileImage(layout->blockdata.at(i)));
+        }
+    }
+
+    const QPointer<Map> target = map;
+    const int revision = map->getPrerenderRevision();
+    const int generation = this->generation;
+    auto watcher = new QFutureWatcher<Map::PrerenderedImages>(this);
+    connect(watcher, &QFutureWatcher<Map::PrerenderedImages>::finished, this, [this, watcher, target, revision, generation] {
+        const Map::PrerenderedImages result = watcher->result();
+        watcher->deleteLater();
+        if (!target || generation != this->generation)
+            return;
+        if (target->setPrerenderedImages(result, revision) && !this->prerenderedMaps.contains(target->name))
+            this->prerenderedMaps.append(target->name);
+    });
+    watcher->setFuture(QtConcurrent::run([images, metatileImages, collisionImages, width, height] {
+        PROFILE_SCOPE("MapPrefetcher::renderImages");
+        Map::PrerenderedImages result = images;
+        result.image = renderPlane(width, height, result.metatileIds, metatileImages);
+        result.collisionImage = renderPlane(width, height, result.collision, collisionImages);
+        return result;
+    }));
+}
@@ -2,6 +2,8 @@
 #include "tileset.h"
 #include "project.h"
 
+#include <QtEndian>
+
 // Stores how each attribute should be laid out for all metatiles, according to the vanilla games.
 // Used to set default config values and import maps with AdvanceMap.
 static const QMap<Metatile::Attr, BitPacker> attributePackersFRLG = {
@@ -21,6 +23,7 @@ static QMap<Metatile::Attr, BitPacker> attributePackers;
 
 Metatile::Metatile(const int numTiles) {
     Tile tile = Tile();
+    this->tiles.reserve(numTiles);
     for (int i = 0; i < numTiles; i++) {
         this->tiles.append(tile);
     }
@@ -52,12 +55,88 @@ QString Metatile::getMetatileIdStrings(const QList<uint16_t> metatileIds) {
     return metatiles.join(",");
 };
 
+// Create metatiles from their on-disk format (numTiles little-endian 16-bit tile values per metatile).
+// Any incomplete metatile at the end of the data is ignored.
+QList<Metatile*> Metatile::deserializeTiles(const QByteArray &data, int numTiles) {
+    QList<Metatile*> metatiles;
+    if (numTiles <= 0)
+        return metatiles;
+
+    const int bytesPerMetatile = 2 * numTiles;
+    const int numMetatiles = data.size() / bytesPerMetatile;
+    metatiles.reserve(numMetatiles);
+
+    const uchar *in = reinterpret_cast<const uchar *>(data.constData());
+    for (int i = 0; i < numMetatiles; i++) {
+        Metatile *metatile = new Metatile;
+        metatile->tiles.reserve(numTiles);
+        for (int j = 0; j < numTiles; j++, in += 2)
+            metatile->tiles.append(Tile(qFromLittleEndian<quint16>(in)));
+        metatiles.append(metatile);
+    }
+    return metatiles;
+}
+
+QByteArray Metatile::serializeTiles(const QList<Metatile*> &metatiles, int numTiles) {
+    QByteArray data(metatiles.length() * numTiles * 2, Qt::Uninitialized);
+    uchar *out = reinterpret_cast<uchar *>(data.data());
+    for (const Metatile *metatile : metatiles) {
+        for (int i = 0; i < numTiles; i++, out += 2)
+            qToLittleEndian<quint16>(metatile->tiles.value(i).rawValue(), out);
+    }
+    return data;
+}
+
+// Read the packed attribute values for each metatile from their on-disk format (one little-endian value of attrSize bytes per metatile).
+QVector<uint32_t> Metatile::deserializeAttributes(const QByteArray &data, int attrSize) {
+    QVector<uint32_t> attributes;
+    if (attrSize <= 0)
+        return attributes;
+
+    const int count = data.size() / attrSize;
+    attributes.resize(count);
+
+    const uchar *in = reinterpret_cast<const uchar *>(data.constData());
+    uint32_t *out = attributes.data();
+    switch (attrSize) {
+    case 4:
+        for (int i = 0; i < count; i++)
+            out[i] = qFromLittleEndian<quint32>(in + i * 4);
+        break;
+    case 2:
+        for (int i = 0; i < count; i++)
+            out[i] = qFromLittleEndian<quint16>(in + i * 2);
+        break;
+    default:
+        for (int i = 0; i < count; i++) {
+            uint32_t value = 0;
+            for (int j = 0; j < attrSize && j < 4; j++)
+                value |= static_cast<uint32_t>(in[i * attrSize + j]) << (8 * j);
+            out[i] = value;
+        }
+        break;
+    }
+    return attributes;
+}
+
+QByteArray Metatile::serializeAttributes(const QList<Metatile*> &metatiles, int attrSize) {
+    QByteArray data(metatiles.length() * attrSize, Qt::Uninitialized);
+    uchar *out = reinterpret_cast<uchar *>(data.data());
+    for (const Metatile *metatile : metatiles) {
+        uint32_t attributes = metatile->getAttributes();
+        for (int i = 0; i < attrSize; i++)
+            *out++ = static_cast<uchar>(attributes >> (8 * i));
+    }
+    return data;
+}
+
 // Read and pack together this metatile's attributes.
 uint32_t Metatile::getAttributes() const {
     uint32_t data = 0;
     for (auto i = this->attributes.cbegin(), end = this->attributes.cend(); i != end; i++){
-        const auto packer = attributePackers.value(i.key());
-        data |= packer.pack(i.value());
+        auto it = attributePackers.constFind(i.key());
+        if (it != attributePackers.cend())
+            data |= it.value().pack(i.value());
     }
     return data;
 }
@@ -65,8 +144,8 @@ uint32_t Metatile::getAttributes() const {
 // Unpack and insert metatile attributes from the given data.
 void Metatile::setAttributes(uint32_t data) {
     for (auto i = attributePackers.cbegin(), end = attributePackers.cend(); i != end; i++){
-        const auto packer = i.value();
-        this->setAttribute(i.key(), packer.unpack(data));
+        const BitPacker &packer = i.value();
+        this->attributes.insert(i.key(), packer.clamp(packer.unpack(data)));
     }
 }
 
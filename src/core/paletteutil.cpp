@@ -1,4 +1,5 @@
 #include "paletteutil.h"
+#include "fileutil.h"
 #include "log.h"
 #include <QFileInfo>
 #include <QRegularExpression>
@@ -38,14 +39,15 @@ QList<QRgb> PaletteUtil::parse(QString filepath, bool *error) {
     return QList<QRgb>();
 }
 
-void PaletteUtil::writeJASC(QString filepath, QVector<QRgb> palette, int offset, int nColors) {
+// Returns the contents of a JASC palette file with the given colors, or an empty array if they're out of range.
+QByteArray PaletteUtil::serializeJASC(const QVector<QRgb> &palette, int offset, int nColors) {
     if (!nColors) {
         logWarn(QString("Cannot save a palette with no colors."));
-        return;
+        return QByteArray();
     }
     if (offset > palette.size() || offset + nColors > palette.size()) {
         logWarn("Palette offset out of range for color table.");
-        return;
+        return QByteArray();
     }
 
     QString text = "JASC-PAL\r\n0100\r\n";
@@ -57,12 +59,17 @@ void PaletteUtil::writeJASC(QString filepath, QVector<QRgb> palette, int offset,
               + QString::number(qGreen(color)) + " "
               + QString::number(qBlue(color)) + "\r\n";
     }
+    return text.toUtf8();
+}
 
-    QFile file(filepath);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(text.toUtf8());
-    } else {
-        logWarn(QString("Could not write to file '%1': ").arg(filepath) + file.errorString());
+void PaletteUtil::writeJASC(QString filepath, QVector<QRgb> palette, int offset, int nColors) {
+    const QByteArray data = serializeJASC(palette, offset, nColors);
+    if (data.isEmpty())
+        return;
+
+    QString error;
+    if (!FileUtil::writeIfChanged(filepath, data, &error)) {
+        logWarn(QString("Could not write to file '%1': ").arg(filepath) + error);
     }
 }
 
@@ -4,6 +4,7 @@
 #include <QRegularExpression>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QStack>
 
 #include "lib/fex/lexer.h"
@@ -637,10 +638,130 @@ bool ParseUtil::tryParseJsonFile(QJsonDocument *out, const QString &filepath) {
     return true;
 }
 
+// Helpers for readJsonFields. Each returns the position just past the end of the item that starts at 'pos',
+// or -1 if the item doesn't end before 'size'.
+static int skipJsonString(const char *data, int pos, int size) {
+    for (pos++; pos < size; pos++) {
+        if (data[pos] == '\\')
+            pos++;
+        else if (data[pos] == '"')
+            return pos + 1;
+    }
+    return -1;
+}
+
+static int skipJsonValue(const char *data, int pos, int size) {
+    if (pos >= size)
+        return -1;
+    if (data[pos] == '"')
+        return skipJsonString(data, pos, size);
+    if (data[pos] == '{' || data[pos] == '[') {
+        int depth = 0;
+        while (pos < size) {
+            char c = data[pos];
+            if (c == '"') {
+                pos = skipJsonString(data, pos, size);
+                if (pos < 0) return -1;
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) return pos + 1;
+            }
+            pos++;
+        }
+        return -1;
+    }
+    // Number or literal
+    static const QByteArray delimiters(",}] \t\r\n");
+    while (pos < size && !delimiters.contains(data[pos]))
+        pos++;
+    return pos;
+}
+
+static int skipJsonWhitespace(const char *data, int pos, int size) {
+    while (pos < size && (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n'))
+        pos++;
+    return pos;
+}
+
+// Reads the values of the given keys from the top level of a JSON object.
+// Unlike parsing the full document, the values of any other keys are skipped over without being decoded,
+// which is much faster when only a few small fields are needed from a large file (e.g. a map's header fields).
+// Keys that aren't present are left out of 'out'. Returns false if the JSON is not a well-formed object.
+bool ParseUtil::readJsonFields(const QByteArray &json, const QStringList &keys, QJsonObject *out) {
+    const char *data = json.constData();
+    const int size = json.size();
+
+    // Skip the UTF-8 byte order mark that some editors add to the start of a file.
+    const int start = json.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+    int pos = skipJsonWhitespace(data, start, size);
+    if (pos >= size || data[pos] != '{')
+        return false;
+    pos = skipJsonWhitespace(data, pos + 1, size);
+    if (pos < size && data[pos] == '}')
+        return true;
+
+    while (pos < size) {
+        // Key
+        if (data[pos] != '"')
+            return false;
+        int end = skipJsonString(data, pos, size);
+        if (end < 0)
+            return false;
+        const QString key = QString::fromUtf8(data + pos + 1, end - pos - 2);
+
+        pos = skipJsonWhitespace(data, end, size);
+        if (pos >= size || data[pos] != ':')
+            return false;
+
+        // Value
+        pos = skipJsonWhitespace(data, pos + 1, size);
+        end = skipJsonValue(data, pos, size);
+        if (end < 0)
+            return false;
+        if (keys.contains(key)) {
+            // Wrap the value in an array, because QJsonDocument can only parse objects and arrays.
+            QJsonParseError parseError;
+            const QByteArray valueJson = '[' + QByteArray::fromRawData(data + pos, end - pos) + ']';
+            const QJsonDocument valueDoc = QJsonDocument::fromJson(valueJson, &parseError);
+            if (parseError.error != QJsonParseError::NoError)
+                return false;
+            out->insert(key, valueDoc.array().at(0));
+        }
+
+        pos = skipJsonWhitespace(data, end, size);
+        if (pos >= size)
+            return false;
+        if (data[pos] == '}')
+            return true;
+        if (data[pos] != ',')
+            return false;
+        pos = skipJsonWhitespace(data, pos + 1, size);
+    }
+    return false;
+}
+
 bool ParseUtil::tryParseOrderedJsonFile(poryjson::Json::object *out, const QString &filepath) {
+    poryjson::Json json;
+    if (!tryParseOrderedJsonFile(&json, filepath))
+        return false;
+    *out = json.object_items();
+    return true;
+}
+
+// Parses the file's UTF-8 contents directly. Prefer this over the object overload
+// for large files, which has to copy the parsed object.
+bool ParseUtil::tryParseOrderedJsonFile(poryjson::Json *out, const QString &filepath) {
+    QFile file(filepath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        logError(QString("Could not open '%1': ").arg(filepath) + file.errorString());
+        return false;
+    }
+
     QString err;
-    QString jsonTxt = readTextFile(filepath);
-    *out = OrderedJson::parse(jsonTxt, err).object_items();
+    *out = OrderedJson::parse(file.readAll(), err);
     if (!err.isEmpty()) {
         logError(QString("Error: Failed to parse json file %1: %2").arg(filepath).arg(err));
         return false;
@@ -789,6 +910,77 @@ QStringList ParseUtil::getGlobalPoryScriptLabels(QString text) {
     return poryScriptLabels;
 }
 
+static int countNewlines(const QString &text, int from, int to) {
+    int count = 0;
+    for (int i = from; i < to; i++) {
+        if (text.at(i) == '\n')
+            count++;
+    }
+    return count;
+}
+
+// Reads every label defined in a script file, along with its line number and whether it's global.
+// This doesn't log anything, so it can be used from other threads.
+QList<ScriptLabel> ParseUtil::readScriptLabels(const QString &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return { };
+
+    const QString text = QString::fromUtf8(file.readAll());
+    if (filePath.endsWith(".inc") || filePath.endsWith(".s"))
+        return getRawScriptLabels(text);
+    else if (filePath.endsWith(".pory"))
+        return getPoryScriptLabels(text);
+    return { };
+}
+
+QList<ScriptLabel> ParseUtil::getRawScriptLabels(QString text, int firstLineNumber) {
+    text = removeStringLiterals(text);
+    text = removeLineComments(text, "@");
+
+    QList<ScriptLabel> labels;
+    int lineNumber = firstLineNumber;
+    int pos = 0;
+    QRegularExpressionMatchIterator it = re_incScriptLabel.globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        const int start = match.capturedStart("label");
+        lineNumber += countNewlines(text, pos, start);
+        pos = start;
+        labels.append({match.captured("label"), lineNumber, match.captured().endsWith("::")});
+    }
+    return labels;
+}
+
+QList<ScriptLabel> ParseUtil::getPoryScriptLabels(QString text) {
+    text = removeStringLiterals(text);
+    text = removeLineComments(text, {"//", "#"});
+
+    QList<ScriptLabel> labels;
+    int lineNumber = 1;
+    int pos = 0;
+    QRegularExpressionMatchIterator it = re_poryScriptLabel.globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        const int start = match.capturedStart("label");
+        lineNumber += countNewlines(text, pos, start);
+        pos = start;
+        labels.append({match.captured("label"), lineNumber, match.captured(3) != "local"});
+    }
+
+    lineNumber = 1;
+    pos = 0;
+    QRegularExpressionMatchIterator raw_it = re_poryRawSection.globalMatch(text);
+    while (raw_it.hasNext()) {
+        const QRegularExpressionMatch match = raw_it.next();
+        const int start = match.capturedStart("raw_script");
+        lineNumber += countNewlines(text, pos, start);
+        pos = start;
+        labels.append(getRawScriptLabels(match.captured("raw_script"), lineNumber));
+    }
+    return labels;
+}
+
 QString ParseUtil::removeStringLiterals(QString text) {
     static const QRegularExpression re_string("\".*\"");
     return text.remove(re_string);
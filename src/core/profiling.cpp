@@ -0,0 +1,223 @@
+#include "profiling.h"
+#include "log.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(Q_OS_UNIX)
+    #include <sys/resource.h>
+#endif
+
+// Beyond these limits durations and trace events are no longer kept, though calls and total times are still counted.
+static const int maxDurationsPerName = 100000;
+static const int maxTraceEvents = 1000000;
+
+std::atomic<bool> Profiling::enabled(false);
+
+namespace {
+
+struct Stats {
+    qint64 calls = 0;
+    qint64 totalTime = 0;
+    QVector<qint64> durations;
+    qint64 bytes = 0;
+    qint64 cacheHits = 0;
+    qint64 cacheMisses = 0;
+};
+
+struct TraceEvent {
+    QString name;
+    int threadId;
+    qint64 start;
+    qint64 duration;
+};
+
+QElapsedTimer profileClock;
+QMutex mutex;
+QHash<QString, Stats> stats;
+QVector<TraceEvent> traceEvents;
+QHash<quintptr, int> threadIds;
+QString tracePath;
+
+// Trace viewers group events by thread, and read small thread ids more easily than native handles.
+int getThreadId() {
+    const quintptr handle = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    auto it = threadIds.constFind(handle);
+    if (it != threadIds.constEnd())
+        return it.value();
+    const int id = threadIds.size() + 1;
+    threadIds.insert(handle, id);
+    return id;
+}
+
+QString formatTime(qint64 nsecs) {
+    return QString::number(nsecs / 1000000.0, 'f', 3) + "ms";
+}
+
+QByteArray escapeJson(const QString &text) {
+    QByteArray escaped;
+    for (const QChar c : text) {
+        if (c == '"' || c == '\\') {
+            escaped.append('\\');
+            escaped.append(c.toLatin1());
+        } else if (c.unicode() < 0x20) {
+            escaped.append(QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0')).toLatin1());
+        } else {
+            escaped.append(QString(c).toUtf8());
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+// Returns the most memory the process has used so far in bytes, or -1 if it can't be determined on this platform.
+qint64 Profiling::peakMemoryUsage() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    return -1;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#if defined(Q_OS_MACOS)
+    return static_cast<qint64>(usage.ru_maxrss); // Bytes on macOS
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024; // Kilobytes elsewhere
+#endif
+#else
+    return -1;
+#endif
+}
+
+void Profiling::init() {
+    if (qEnvironmentVariableIsEmpty("PORYMAP_PROFILE") && qEnvironmentVariableIsEmpty("PORYMAP_TRACE"))
+        return;
+    tracePath = qEnvironmentVariable("PORYMAP_TRACE");
+    profileClock.start();
+    enabled = true;
+}
+
+// Logs the collected statistics, and writes the trace file if one was requested.
+void Profiling::finish() {
+    if (!isEnabled())
+        return;
+    enabled = false;
+    logInfo(summary());
+    if (!tracePath.isEmpty() && writeTrace(tracePath))
+        logInfo(QString("Wrote performance trace to '%1'").arg(tracePath));
+}
+
+// The time since profiling started, in nanoseconds.
+qint64 Profiling::now() {
+    return profileClock.nsecsElapsed();
+}
+
+void Profiling::record(const QString &name, qint64 start, qint64 duration) {
+    QMutexLocker locker(&mutex);
+    Stats &entry = stats[name];
+    entry.calls++;
+    entry.totalTime += duration;
+    if (entry.durations.length() < maxDurationsPerName)
+        entry.durations.append(duration);
+    if (!tracePath.isEmpty() && traceEvents.length() < maxTraceEvents)
+        traceEvents.append({name, getThreadId(), start, duration});
+}
+
+void Profiling::addBytes(const QString &name, qint64 bytes) {
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mutex);
+    stats[name].bytes += bytes;
+}
+
+void Profiling::addCacheResult(const QString &name, bool hit) {
+    if (!isEnabled())
+        return;
+    QMutexLocker locker(&mutex);
+    Stats &entry = stats[name];
+    if (hit) {
+        entry.cacheHits++;
+    } else {
+        entry.cacheMisses++;
+    }
+}
+
+QString Profiling::summary() {
+    QMutexLocker locker(&mutex);
+    QStringList names = stats.keys();
+    names.sort();
+
+    QStringList lines;
+    lines.append("Performance summary:");
+    for (const QString &name : names) {
+        Stats &entry = stats[name];
+        QStringList values;
+        if (entry.calls) {
+            std::sort(entry.durations.begin(), entry.durations.end());
+            const qint64 p99 = entry.durations.isEmpty() ? 0 : entry.durations.at((entry.durations.length() - 1) * 99 / 100);
+            values.append(QString("%1 calls").arg(entry.calls));
+            values.append(QString("total %1").arg(formatTime(entry.totalTime)));
+            values.append(QString("mean %1").arg(formatTime(entry.totalTime / entry.calls)));
+            values.append(QString("p99 %1").arg(formatTime(p99)));
+        }
+        if (entry.bytes) {
+            values.append(QString("%1 bytes").arg(entry.bytes));
+            if (entry.totalTime > 0)
+                values.append(QString("%1 MiB/s").arg(entry.bytes / (1024.0 * 1024.0) / (entry.totalTime / 1000000000.0), 0, 'f', 2));
+        }
+        if (entry.cacheHits || entry.cacheMisses)
+            values.append(QString("%1/%2 cache hits").arg(entry.cacheHits).arg(entry.cacheHits + entry.cacheMisses));
+        lines.append(QString("  %1: %2").arg(name).arg(values.join(", ")));
+    }
+    const qint64 peakMemory = peakMemoryUsage();
+    if (peakMemory >= 0)
+        lines.append(QString("  Peak memory usage: %1 MiB").arg(peakMemory / (1024.0 * 1024.0), 0, 'f', 1));
+    return lines.join("\n");
+}
+
+// Writes the recorded operations in the Chrome trace-event format, as complete ("X") events with times in microseconds.
+bool Profiling::writeTrace(const QString &filepath) {
+    QMutexLocker locker(&mutex);
+    QFile file(filepath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        logError(QString("Could not open '%1' for writing: ").arg(filepath) + file.errorString());
+        return false;
+    }
+
+    QByteArray data;
+    data.append("{\"traceEvents\":[\n");
+    for (int i = 0; i < traceEvents.length(); i++) {
+        const TraceEvent &event = traceEvents.at(i);
+        data.append("{\"name\":\"");
+        data.append(escapeJson(event.name));
+        data.append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+        data.append(QByteArray::number(event.threadId));
+        data.append(",\"ts\":");
+        data.append(QByteArray::number(event.start / 1000.0, 'f', 3));
+        data.append(",\"dur\":");
+        data.append(QByteArray::number(event.duration / 1000.0, 'f', 3));
+        data.append(i + 1 < traceEvents.length() ? "},\n" : "}\n");
+        if (data.size() >= (1 << 20)) {
+            file.write(data);
+            data.clear();
+        }
+    }
+    data.append("],\"displayTimeUnit\":\"ms\"}\n");
+    file.write(data);
+    if (!file.flush()) {
+        logError(QString("Could not write '%1': ").arg(filepath) + file.errorString());
+        return false;
+    }
+    return true;
+}
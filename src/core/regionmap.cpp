@@ -25,19 +25,14 @@ RegionMap::RegionMap(Project *project) :
     this->project = project;
 }
 
-bool RegionMap::loadMapData(poryjson::Json data) {
-    poryjson::Json::object mapObject = data.object_items();
-
-    this->alias = mapObject["alias"].string_value();
-
-    poryjson::Json tilemapJson = mapObject["tilemap"];
-    poryjson::Json layoutJson = mapObject["layout"];
+bool RegionMap::loadMapData(const poryjson::Json &data) {
+    this->alias = data["alias"].string_value();
 
     this->tilemap.clear();
     this->layout_layers.clear();
     this->layouts.clear();
 
-    return loadTilemap(tilemapJson) && loadLayout(layoutJson);
+    return loadTilemap(data["tilemap"]) && loadLayout(data["layout"]);
 }
 
 int RegionMap::tilemapBytes() {
@@ -59,11 +54,9 @@ int RegionMap::tilemapBytes() {
     return tilemapSize() * multiplier;
 }
 
-bool RegionMap::loadTilemap(poryjson::Json tilemapJson) {
+bool RegionMap::loadTilemap(const poryjson::Json &tilemapObject) {
     bool errored = false;
 
-    poryjson::Json::object tilemapObject = tilemapJson.object_items();
-
     this->tilemap_width = tilemapObject["width"].int_value();
     this->tilemap_height = tilemapObject["height"].int_value();
 
@@ -75,7 +68,7 @@ bool RegionMap::loadTilemap(poryjson::Json tilemapJson) {
     this->tileset_path = tilemapObject["tileset_path"].string_value();
     this->tilemap_path = tilemapObject["tilemap_path"].string_value();
 
-    if (tilemapObject.contains("palette")) {
+    if (tilemapObject.has_key("palette")) {
         this->palette_path = tilemapObject["palette"].string_value();
     }
 
@@ -98,16 +91,14 @@ bool RegionMap::loadTilemap(poryjson::Json tilemapJson) {
     return !errored;
 }
 
-bool RegionMap::loadLayout(poryjson::Json layoutJson) {
-    if (layoutJson.is_null()) {
+bool RegionMap::loadLayout(const poryjson::Json &layoutObject) {
+    if (layoutObject.is_null()) {
         this->layout_format = LayoutFormat::None;
         return true;
     }
 
     this->layout_constants.clear();
 
-    poryjson::Json::object layoutObject = layoutJson.object_items();
-
     QString layoutFormat = layoutObject["format"].string_value();
     QMap<QString, LayoutFormat> layoutFormatMap = { {"binary", LayoutFormat::Binary}, {"C array", LayoutFormat::CArray} };
     this->layout_format = layoutFormatMap[layoutFormat];
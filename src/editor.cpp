@@ -2,6 +2,7 @@
 #include "draggablepixmapitem.h"
 #include "imageproviders.h"
 #include "log.h"
+#include "profiling.h"
 #include "mapconnection.h"
 #include "currentselectedmetatilespixmapitem.h"
 #include "mapsceneeventfilter.h"
@@ -59,6 +60,7 @@ Editor::~Editor()
 }
 
 void Editor::saveProject() {
+    PROFILE_SCOPE("Editor::saveProject");
     if (project) {
         saveUiFields();
         project->saveAllMaps();
@@ -67,6 +69,7 @@ void Editor::saveProject() {
 }
 
 void Editor::save() {
+    PROFILE_SCOPE("Editor::save");
     if (project && map) {
         saveUiFields();
         project->saveMap(map);
@@ -79,6 +82,8 @@ void Editor::saveUiFields() {
 }
 
 void Editor::closeProject() {
+    // The encounter tables refer to the project, so they can't be reused.
+    clearWildMonTables();
     if (this->project) {
         delete this->project;
         this->project = nullptr;
@@ -99,7 +104,7 @@ void Editor::setEditingMap() {
     if (events_group) {
         events_group->setVisible(false);
     }
-    setBorderItemsVisible(ui->checkBox_ToggleBorder->isChecked());
+    setBorderItemVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionItemsVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionsEditable(false);
     this->cursorMapTileRect->stopSingleTileMode();
@@ -123,7 +128,7 @@ void Editor::setEditingCollision() {
     if (events_group) {
         events_group->setVisible(false);
     }
-    setBorderItemsVisible(ui->checkBox_ToggleBorder->isChecked());
+    setBorderItemVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionItemsVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionsEditable(false);
     this->cursorMapTileRect->setSingleTileMode();
@@ -146,7 +151,7 @@ void Editor::setEditingObjects() {
     if (collision_item) {
         collision_item->setVisible(false);
     }
-    setBorderItemsVisible(ui->checkBox_ToggleBorder->isChecked());
+    setBorderItemVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionItemsVisible(ui->checkBox_ToggleBorder->isChecked());
     setConnectionsEditable(false);
     this->cursorMapTileRect->setSingleTileMode();
@@ -196,7 +201,7 @@ void Editor::setEditingConnections() {
     if (events_group) {
         events_group->setVisible(false);
     }
-    setBorderItemsVisible(true, 0.4);
+    setBorderItemVisible(true, 0.4);
     setConnectionItemsVisible(true);
     setConnectionsEditable(true);
     this->cursorMapTileRect->setSingleTileMode();
@@ -207,11 +212,11 @@ void Editor::displayWildMonTables() {
     QStackedWidget *stack = ui->stackedWidget_WildMons;
     QComboBox *labelCombo = ui->comboBox_EncounterGroupLabel;
 
-    // delete widgets from previous map data if they exist
+    // Keep the widgets from the previous map data to reuse them
     while (stack->count()) {
-        QWidget *oldWidget = stack->widget(0);
+        MonTabWidget *oldWidget = static_cast<MonTabWidget *>(stack->widget(0));
         stack->removeWidget(oldWidget);
-        delete oldWidget;
+        unusedMonTabWidgets.append(oldWidget);
     }
 
     labelCombo->clear();
@@ -221,36 +226,43 @@ void Editor::displayWildMonTables() {
         return;
     }
 
-    for (auto groupPair : project->wildMonData[map->constantName])
-        labelCombo->addItem(groupPair.first);
+    const tsl::ordered_map<QString, WildPokemonHeader> &encounterMap = project->wildMonData[map->constantName];
+    for (const auto &labelPair : encounterMap)
+        labelCombo->addItem(labelPair.first);
 
     labelCombo->setCurrentText(labelCombo->itemText(0));
 
+    // The tables are only filled in when they're displayed.
     int labelIndex = 0;
-    for (auto labelPair : project->wildMonData[map->constantName]) {
-
-        QString label = labelPair.first;
-
-        WildPokemonHeader header = project->wildMonData[map->constantName][label];
-
-        MonTabWidget *tabWidget = new MonTabWidget(this);
+    for (const auto &labelPair : encounterMap) {
+        MonTabWidget *tabWidget = takeMonTabWidget();
         stack->insertWidget(labelIndex++, tabWidget);
+        tabWidget->load(map->constantName, labelPair.first);
+    }
+    stack->setCurrentIndex(0);
+}
 
-        int tabIndex = 0;
-        for (EncounterField monField : project->wildMonFields) {
-            QString fieldName = monField.name;
-
-            tabWidget->clearTableAt(tabIndex);
+// Returns an unused tab widget for a wild encounter group, creating one if none can be reused.
+MonTabWidget *Editor::takeMonTabWidget() {
+    while (!unusedMonTabWidgets.isEmpty()) {
+        MonTabWidget *tabWidget = unusedMonTabWidgets.takeLast();
+        if (tabWidget->hasFields(project->wildMonFields))
+            return tabWidget;
+        delete tabWidget;
+    }
+    return new MonTabWidget(this);
+}
 
-            if (project->wildMonData.contains(map->constantName) && header.wildMons[fieldName].active) {
-                tabWidget->populateTab(tabIndex, header.wildMons[fieldName]);
-            } else {
-                tabWidget->setTabActive(tabIndex, false);
-            }
-            tabIndex++;
-        }
+void Editor::clearWildMonTables() {
+    QStackedWidget *stack = ui->stackedWidget_WildMons;
+    while (stack->count()) {
+        QWidget *oldWidget = stack->widget(0);
+        stack->removeWidget(oldWidget);
+        delete oldWidget;
     }
-    stack->setCurrentIndex(0);
+    qDeleteAll(unusedMonTabWidgets);
+    unusedMonTabWidgets.clear();
+    ui->comboBox_EncounterGroupLabel->clear();
 }
 
 void Editor::addNewWildMonGroup(QWidget *window) {
@@ -334,7 +346,8 @@ void Editor::addNewWildMonGroup(QWidget *window) {
             header.wildMons[fieldName].encounterRate = 0;
         }
 
-        MonTabWidget *tabWidget = new MonTabWidget(this);
+        MonTabWidget *tabWidget = takeMonTabWidget();
+        tabWidget->load(map->constantName, lineEdit->text());
         stack->insertWidget(stack->count(), tabWidget);
 
         labelCombo->addItem(lineEdit->text());
@@ -348,9 +361,7 @@ void Editor::addNewWildMonGroup(QWidget *window) {
                 if (copyCheckbox->isChecked()) {
                     MonTabWidget *copyFrom = static_cast<MonTabWidget *>(stack->widget(stackIndex));
                     if (copyFrom->isTabEnabled(tabIndex)) {
-                        QTableView *monTable = copyFrom->tableAt(tabIndex);
-                        EncounterTableModel *model = static_cast<EncounterTableModel *>(monTable->model());
-                        header.wildMons[fieldName] = model->encounterData();
+                        header.wildMons[fieldName] = copyFrom->encounterData(tabIndex);
                     }
                     else {
                         header.wildMons[fieldName] = getDefaultMonInfo(monField);
@@ -683,9 +694,10 @@ void Editor::saveEncounterTabData() {
                 continue;
             }
 
-            QTableView *monTable = tabWidget->tableAt(fieldIndex - 1);
-            EncounterTableModel *model = static_cast<EncounterTableModel *>(monTable->model());
-            encounterHeader.wildMons[fieldName] = model->encounterData();
+            // Tables that haven't been displayed can't have been edited, the project already has their data.
+            if (!tabWidget->isTabPopulated(fieldIndex - 1))
+                continue;
+            encounterHeader.wildMons[fieldName] = tabWidget->encounterData(fieldIndex - 1);
         }
     }
 }
@@ -779,10 +791,10 @@ void Editor::setConnectionItemsVisible(bool visible) {
     }
 }
 
-void Editor::setBorderItemsVisible(bool visible, qreal opacity) {
-    for (QGraphicsPixmapItem* item : borderItems) {
-        item->setVisible(visible);
-        item->setOpacity(opacity);
+void Editor::setBorderItemVisible(bool visible, qreal opacity) {
+    if (borderItem) {
+        borderItem->setVisible(visible);
+        borderItem->setOpacity(opacity);
     }
 }
 
@@ -925,7 +937,7 @@ void Editor::onConnectionDirectionChanged(QString newDirection) {
 
 void Editor::onBorderMetatilesChanged() {
     displayMapBorder();
-    setBorderItemsVisible(ui->checkBox_ToggleBorder->isChecked());
+    setBorderItemVisible(ui->checkBox_ToggleBorder->isChecked());
 }
 
 void Editor::onHoveredMovementPermissionChanged(uint16_t collision, uint16_t elevation) {
@@ -1098,6 +1110,7 @@ QString Editor::getMovementPermissionText(uint16_t collision, uint16_t elevation
 }
 
 bool Editor::setMap(QString map_name) {
+    PROFILE_SCOPE("Editor::setMap");
     if (map_name.isEmpty()) {
         return false;
     }
@@ -1337,6 +1350,7 @@ void Editor::mouseEvent_collision(QGraphicsSceneMouseEvent *event, CollisionPixm
 }
 
 bool Editor::displayMap() {
+    PROFILE_SCOPE("Editor::displayMap");
     if (!scene) {
         scene = new QGraphicsScene;
         MapSceneEventFilter *filter = new MapSceneEventFilter();
@@ -1626,38 +1640,47 @@ void Editor::maskNonVisibleConnectionTiles() {
 }
 
 void Editor::displayMapBorder() {
-    for (QGraphicsPixmapItem* item : borderItems) {
-        if (item->scene()) {
-            item->scene()->removeItem(item);
+    if (borderItem) {
+        if (borderItem->scene()) {
+            borderItem->scene()->removeItem(borderItem);
         }
-        delete item;
+        delete borderItem;
+        borderItem = nullptr;
     }
-    borderItems.clear();
 
-    int borderWidth = map->getBorderWidth();
-    int borderHeight = map->getBorderHeight();
-    int borderHorzDist = getBorderDrawDistance(borderWidth);
-    int borderVertDist = getBorderDrawDistance(borderHeight);
-    QPixmap pixmap = map->renderBorder();
-    for (int y = -borderVertDist; y < map->getHeight() + borderVertDist; y += borderHeight)
-    for (int x = -borderHorzDist; x < map->getWidth() + borderHorzDist; x += borderWidth) {
-        QGraphicsPixmapItem *item = new QGraphicsPixmapItem(pixmap);
-        item->setX(x * 16);
-        item->setY(y * 16);
-        item->setZValue(-3);
-        scene->addItem(item);
-        borderItems.append(item);
-    }
+    // The border is a single item that repeats the border image, starting from the top-left corner of the border area.
+    int borderHorzDist = getBorderDrawDistance(map->getBorderWidth());
+    int borderVertDist = getBorderDrawDistance(map->getBorderHeight());
+    borderItem = new QGraphicsRectItem(0, 0, (map->getWidth() + borderHorzDist * 2) * 16, (map->getHeight() + borderVertDist * 2) * 16);
+    borderItem->setPen(Qt::NoPen);
+    borderItem->setX(-borderHorzDist * 16);
+    borderItem->setY(-borderVertDist * 16);
+    borderItem->setZValue(-3);
+    setBorderPixmap(map->renderBorder());
+    scene->addItem(borderItem);
 }
 
 void Editor::updateMapBorder() {
-    QPixmap pixmap = this->map->renderBorder(true);
-    for (auto item : this->borderItems) {
-        item->setPixmap(pixmap);
+    setBorderPixmap(this->map->renderBorder(true));
+}
+
+void Editor::setBorderPixmap(const QPixmap &pixmap) {
+    if (!borderItem)
+        return;
+    if (pixmap.isNull()) {
+        borderItem->setBrush(Qt::NoBrush);
+    } else {
+        borderItem->setBrush(QBrush(pixmap));
     }
 }
 
 void Editor::updateMapConnections() {
+    // The contents of the tilesets may have changed, so any images rendered with them are out of date.
+    for (Map *cachedMap : project->mapCache) {
+        cachedMap->clearConnectionCache();
+        cachedMap->clearPrerenderedImages();
+    }
+
     for (int i = 0; i < connection_items.size(); i++) {
         Map *connected_map = project->getMap(connection_items[i]->connection->map_name);
         if (!connected_map)
@@ -1689,28 +1712,8 @@ void Editor::onToggleGridClicked(bool checked) {
 }
 
 void Editor::displayMapGrid() {
-    for (QGraphicsLineItem* item : gridLines) {
-        if (item) delete item;
-    }
-    gridLines.clear();
+    // The grid is drawn by the map view, only within the area being repainted.
     ui->checkBox_ToggleGrid->disconnect();
-
-    int pixelWidth = map->getWidth() * 16;
-    int pixelHeight = map->getHeight() * 16;
-    for (int i = 0; i <= map->getWidth(); i++) {
-        int x = i * 16;
-        QGraphicsLineItem *line = new QGraphicsLineItem(x, 0, x, pixelHeight);
-        line->setVisible(ui->checkBox_ToggleGrid->isChecked());
-        gridLines.append(line);
-        connect(ui->checkBox_ToggleGrid, &QCheckBox::toggled, [=](bool checked){line->setVisible(checked);});
-    }
-    for (int j = 0; j <= map->getHeight(); j++) {
-        int y = j * 16;
-        QGraphicsLineItem *line = new QGraphicsLineItem(0, y, pixelWidth, y);
-        line->setVisible(ui->checkBox_ToggleGrid->isChecked());
-        gridLines.append(line);
-        connect(ui->checkBox_ToggleGrid, &QCheckBox::toggled, [=](bool checked){line->setVisible(checked);});
-    }
     connect(ui->checkBox_ToggleGrid, &QCheckBox::toggled, this, &Editor::onToggleGridClicked);
 }
 
@@ -1828,6 +1831,7 @@ void Editor::updateMirroredConnection(MapConnection* connection, QString origina
     if (isDelete) {
         if (mirrorConnection) {
             otherMap->connections.removeOne(mirrorConnection);
+            otherMap->hasUnsavedDataChanges = true;
             delete mirrorConnection;
         }
         return;
@@ -1836,9 +1840,12 @@ void Editor::updateMirroredConnection(MapConnection* connection, QString origina
     if (connection->direction != originalDirection || connection->map_name != originalMapName) {
         if (mirrorConnection) {
             otherMap->connections.removeOne(mirrorConnection);
+            otherMap->hasUnsavedDataChanges = true;
             delete mirrorConnection;
             mirrorConnection = nullptr;
             otherMap = project->getMap(connection->map_name);
+            if (!otherMap)
+                return;
         }
     }
 
@@ -1851,6 +1858,9 @@ void Editor::updateMirroredConnection(MapConnection* connection, QString origina
     }
 
     mirrorConnection->offset = -connection->offset;
+
+    // The connected map isn't the one being edited, so it needs to be marked for saving explicitly.
+    otherMap->hasUnsavedDataChanges = true;
 }
 
 void Editor::removeCurrentConnection() {
@@ -1944,7 +1954,7 @@ void Editor::updateSecondaryTileset(QString tilesetLabel, bool forceLoad)
 
 void Editor::toggleBorderVisibility(bool visible, bool enableScriptCallback)
 {
-    this->setBorderItemsVisible(visible);
+    this->setBorderItemVisible(visible);
     this->setConnectionItemsVisible(visible);
     porymapConfig.setShowBorder(visible);
     if (enableScriptCallback)
@@ -1976,16 +1986,12 @@ void Editor::redrawObject(DraggablePixmapItem *item) {
         qreal opacity = item->event->getUsingSprite() ? 1.0 : 0.7;
         item->setOpacity(opacity);
         project->setEventPixmap(item->event, true);
-        item->setPixmap(item->event->getPixmap());
+        // Sprite frames are cached, so this is usually the pixmap the item already has.
+        const QPixmap pixmap = item->event->getPixmap();
+        if (pixmap.cacheKey() != item->pixmap().cacheKey())
+            item->setPixmap(pixmap);
         item->setShapeMode(QGraphicsPixmapItem::BoundingRectShape);
-        if (selected_events && selected_events->contains(item)) {
-            QImage image = item->pixmap().toImage();
-            QPainter painter(&image);
-            painter.setPen(QColor(255, 0, 255));
-            painter.drawRect(0, 0, image.width() - 1, image.height() - 1);
-            painter.end();
-            item->setPixmap(QPixmap::fromImage(image));
-        }
+        item->setSelectionOutline(selected_events && selected_events->contains(item));
         item->updatePosition();
     }
 }
@@ -2137,9 +2143,8 @@ DraggablePixmapItem *Editor::addNewEvent(Event::Type type) {
             event = new HealLocationEvent();
             event->setMap(this->map);
             event->setDefaultValues(this->project);
-            HealLocation healLocation = HealLocation::fromEvent(event);
-            project->healLocations.append(healLocation);
-            ((HealLocationEvent *)event)->setIndex(project->healLocations.length());
+            int index = project->addHealLocation(HealLocation::fromEvent(event));
+            ((HealLocationEvent *)event)->setIndex(index);
             break;
         }
         default:
@@ -2171,18 +2176,10 @@ void Editor::openMapScripts() const {
 }
 
 void Editor::openScript(const QString &scriptLabel) const {
-    // Find the location of scriptLabel.
-    QStringList scriptPaths(map->getScriptsFilePath());
-    scriptPaths << project->getEventScriptsFilePaths();
+    // Find the location of scriptLabel, preferring the map's scripts file.
+    QString scriptPath = map->getScriptsFilePath();
     int lineNum = 0;
-    QString scriptPath = scriptPaths.first();
-    for (const auto &path : scriptPaths) {
-        lineNum = ParseUtil::getScriptLineNumber(path, scriptLabel);
-        if (lineNum != 0) {
-            scriptPath = path;
-            break;
-        }
-    }
+    project->findScriptLabel(scriptLabel, scriptPath, &scriptPath, &lineNum);
 
     openInTextEditor(scriptPath, lineNum);
 }
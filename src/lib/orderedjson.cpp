@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <limits>
 
 namespace poryjson {
@@ -48,110 +49,188 @@ struct NullStruct {
  * Serialization
  */
 
-static void dump(NullStruct, QString &out, int *indent) {
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    out += "null";
+JsonWriter::JsonWriter(QIODevice *device, int indent, bool afterKey)
+    : m_device(device), m_indent(indent), m_afterKey(afterKey) {
+    if (m_device) m_buffer.reserve(flush_size * 2);
 }
 
-static void dump(double value, QString &out, int *indent) {
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    if (std::isfinite(value)) {
-        char buf[32];
-        snprintf(buf, sizeof buf, "%.17g", value);
-        out += buf;
+JsonWriter::~JsonWriter() {
+    flush();
+}
+
+void JsonWriter::flush() {
+    if (m_device && !m_buffer.isEmpty()) {
+        m_device->write(m_buffer);
+        m_buffer.clear();
+    }
+}
+
+void JsonWriter::writeIndent() {
+    static const QByteArray spaces(128, ' ');
+    int count = m_indent * 2;
+    while (count > 0) {
+        const int n = qMin(count, static_cast<int>(spaces.size()));
+        m_buffer.append(spaces.constData(), n);
+        count -= n;
+    }
+}
+
+// Every value is indented on its own line, except for object values which follow their key.
+void JsonWriter::beginValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
     } else {
-        out += "null";
+        writeIndent();
     }
 }
 
-static void dump(int value, QString &out, int *indent) {
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    char buf[32];
-    snprintf(buf, sizeof buf, "%d", value);
-    out += buf;
+void JsonWriter::endValue() {
+    if (m_device && m_buffer.size() >= flush_size)
+        flush();
 }
 
-static void dump(bool value, QString &out, int *indent) {
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    out += value ? "true" : "false";
+void JsonWriter::writeKey(const QString &key) {
+    writeIndent();
+    writeString(key);
+    m_buffer.append(": ", 2);
+    m_afterKey = true;
 }
 
-static void dump(const QString &value, QString &out, int *indent, bool isKey = false) {
-    if (!isKey && !out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    out += '"';
-    for (int i = 0; i < value.length(); i++) {
-        const char ch = value[i].unicode();
+void JsonWriter::writeString(const QString &value) {
+    m_buffer.append('"');
+    const QChar *data = value.constData();
+    const int length = value.length();
+    int i = 0;
+    while (i < length) {
+        const ushort ch = data[i].unicode();
+        if (ch >= 0x80 && ch != 0x2028 && ch != 0x2029) {
+            // Convert runs of non-ASCII characters together, so surrogate pairs stay intact.
+            const int start = i;
+            while (i < length && data[i].unicode() >= 0x80 && data[i].unicode() != 0x2028 && data[i].unicode() != 0x2029)
+                i++;
+            m_buffer.append(QStringView(data + start, i - start).toUtf8());
+            continue;
+        }
         if (ch == '\\') {
-            out += "\\\\";
+            m_buffer.append("\\\\", 2);
         } else if (ch == '"') {
-            out += "\\\"";
+            m_buffer.append("\\\"", 2);
         } else if (ch == '\b') {
-            out += "\\b";
+            m_buffer.append("\\b", 2);
         } else if (ch == '\f') {
-            out += "\\f";
+            m_buffer.append("\\f", 2);
         } else if (ch == '\n') {
-            out += "\\n";
+            m_buffer.append("\\n", 2);
         } else if (ch == '\r') {
-            out += "\\r";
+            m_buffer.append("\\r", 2);
         } else if (ch == '\t') {
-            out += "\\t";
-        } else if (static_cast<uint8_t>(ch) <= 0x1f) {
+            m_buffer.append("\\t", 2);
+        } else if (ch <= 0x1f || ch == 0x2028 || ch == 0x2029) {
             char buf[8];
             snprintf(buf, sizeof buf, "\\u%04x", ch);
-            out += buf;
-        } else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(value[i+1].unicode()) == 0x80
-                   && static_cast<uint8_t>(value[i+2].unicode()) == 0xa8) {
-            out += "\\u2028";
-            i += 2;
-        } else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(value[i+1].unicode()) == 0x80
-                   && static_cast<uint8_t>(value[i+2].unicode()) == 0xa9) {
-            out += "\\u2029";
-            i += 2;
+            m_buffer.append(buf, 6);
         } else {
-            out += ch;
+            m_buffer.append(static_cast<char>(ch));
         }
+        i++;
+    }
+    m_buffer.append('"');
+}
+
+static void dump(NullStruct, JsonWriter &writer) {
+    writer.beginValue();
+    writer.write("null", 4);
+    writer.endValue();
+}
+
+static void dump(double value, JsonWriter &writer) {
+    writer.beginValue();
+    if (std::isfinite(value)) {
+        char buf[32];
+        const int n = snprintf(buf, sizeof buf, "%.17g", value);
+        writer.write(buf, n);
+    } else {
+        writer.write("null", 4);
     }
-    out += '"';
+    writer.endValue();
+}
+
+static void dump(int value, JsonWriter &writer) {
+    writer.beginValue();
+    char buf[32];
+    const int n = snprintf(buf, sizeof buf, "%d", value);
+    writer.write(buf, n);
+    writer.endValue();
 }
 
-static void dump(const Json::array &values, QString &out, int *indent) {
+static void dump(bool value, JsonWriter &writer) {
+    writer.beginValue();
+    if (value)
+        writer.write("true", 4);
+    else
+        writer.write("false", 5);
+    writer.endValue();
+}
+
+static void dump(const QString &value, JsonWriter &writer) {
+    writer.beginValue();
+    writer.writeString(value);
+    writer.endValue();
+}
+
+static void dump(const Json::array &values, JsonWriter &writer) {
     bool first = true;
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    out += "[\n";
-    *indent += 1;
+    writer.beginValue();
+    writer.write("[\n", 2);
+    writer.increaseIndent();
     for (const auto &value : values) {
         if (!first) {
-            out += ",\n";
+            writer.write(",\n", 2);
         }
-        value.dump(out, indent);
+        value.dump(writer);
         first = false;
     }
-    *indent -= 1;
-    out += "\n" + QString(*indent * 2, ' ') + "]";
+    writer.decreaseIndent();
+    writer.write('\n');
+    writer.writeIndent();
+    writer.write(']');
+    writer.endValue();
 }
 
-static void dump(const Json::object &values, QString &out, int *indent) {
+static void dump(const Json::object &values, JsonWriter &writer) {
     bool first = true;
-    if (!out.endsWith(": ")) out += QString(*indent * 2, ' ');
-    out += "{\n";
-    *indent += 1;
-    for (auto kv : values) {
+    writer.beginValue();
+    writer.write("{\n", 2);
+    writer.increaseIndent();
+    for (const auto &kv : values) {
         if (!first) {
-            out += ",\n";
+            writer.write(",\n", 2);
         }
-        out += QString(*indent * 2, ' ');
-        dump(kv.first, out, indent, true);
-        out += ": ";
-        kv.second.dump(out, indent);
+        writer.writeKey(kv.first);
+        kv.second.dump(writer);
         first = false;
     }
-    *indent -= 1;
-    out += "\n" + QString(*indent * 2, ' ') + "}";
+    writer.decreaseIndent();
+    writer.write('\n');
+    writer.writeIndent();
+    writer.write('}');
+    writer.endValue();
 }
 
+void Json::dump(JsonWriter &writer) const {
+    m_ptr->dump(writer);
+}
 
 void Json::dump(QString &out, int *indent) const {
-    m_ptr->dump(out, indent);
+    // A value appended directly after a key isn't indented.
+    JsonWriter writer(nullptr, *indent, out.endsWith(": "));
+    dump(writer);
+    out += QString::fromUtf8(writer.buffer());
+}
+
+void Json::dump(QIODevice *device, int indent) const {
+    JsonWriter writer(device, indent);
+    dump(writer);
 }
 
 /* * * * * * * * * * * * * * * * * * * *
@@ -180,7 +259,7 @@ protected:
     }
 
     const T m_value;
-    void dump(QString &out, int *indent) const override { poryjson::dump(m_value, out, indent); }
+    void dump(JsonWriter &writer) const override { poryjson::dump(m_value, writer); }
 };
 
 class JsonDouble final : public Value<Json::NUMBER, double> {
@@ -300,7 +379,7 @@ const Json &              JsonValue::operator[] (int)         const { return sta
 const Json &              JsonValue::operator[] (const QString &) const { return static_null(); }
 
 const Json & JsonObject::operator[] (const QString &key) const {
-    static auto iter = m_value.find(key);
+    auto iter = m_value.find(key);
     return (iter == m_value.end()) ? static_null() : (*iter).second;
 }
 const Json & JsonArray::operator[] (int i) const {
@@ -383,12 +462,15 @@ namespace {
 /* JsonParser
  *
  * Object that tracks all state of an in-progress parse.
+ * The input is parsed directly as UTF-8. The buffer is null-terminated (it comes from a QByteArray),
+ * so reading the character at str[size] is safe and yields 0.
  */
 struct JsonParser final {
 
     /* State
      */
-    const QString &str;
+    const char *str;
+    int size;
     int i;
     QString &err;
     bool failed;
@@ -415,7 +497,7 @@ struct JsonParser final {
      * Advance until the current character is non-whitespace.
      */
     void consume_whitespace() {
-        while (i < str.length() && (str[i] == ' ' || str[i] == '\r' || str[i] == '\n' || str[i] == '\t'))
+        while (i < size && (str[i] == ' ' || str[i] == '\r' || str[i] == '\n' || str[i] == '\t'))
             i++;
     }
 
@@ -427,24 +509,24 @@ struct JsonParser final {
       bool comment_found = false;
       if (str[i] == '/') {
         i++;
-        if (i == str.size())
+        if (i == size)
           return fail("unexpected end of input after start of comment", false);
         if (str[i] == '/') { // inline comment
           i++;
           // advance until next line, or end of input
-          while (i < str.size() && str[i] != '\n') {
+          while (i < size && str[i] != '\n') {
             i++;
           }
           comment_found = true;
         }
         else if (str[i] == '*') { // multiline comment
           i++;
-          if (i > str.size()-2)
+          if (i > size-2)
             return fail("unexpected end of input inside multi-line comment", false);
           // advance until closing tokens
           while (!(str[i] == '*' && str[i+1] == '/')) {
             i++;
-            if (i > str.size()-2)
+            if (i > size-2)
               return fail(
                 "unexpected end of input inside multi-line comment", false);
           }
@@ -482,17 +564,17 @@ struct JsonParser final {
     char get_next_token() {
         consume_garbage();
         if (failed) return static_cast<char>(0);
-        if (i == str.size())
+        if (i == size)
             return fail("unexpected end of input", static_cast<char>(0));
 
-        return str[i++].unicode();
+        return str[i++];
     }
 
     /* encode_utf8(pt, out)
      *
      * Encode pt as UTF-8 and add it to out.
      */
-    void encode_utf8(long pt, QString & out) {
+    void encode_utf8(long pt, QByteArray & out) {
         if (pt < 0)
             return;
 
@@ -516,22 +598,31 @@ struct JsonParser final {
     /* parse_string()
      *
      * Parse a QString, starting at the current position.
+     * Strings without escapes (nearly all of them) are converted straight from the input buffer.
      */
     QString parse_string() {
-        QString out;
+        const int start = i;
+        while (i < size && str[i] != '"' && str[i] != '\\' && !in_range(static_cast<uint8_t>(str[i]), 0, 0x1f))
+            i++;
+        if (i < size && str[i] == '"') {
+            i++;
+            return QString::fromUtf8(str + start, i - 1 - start);
+        }
+
+        QByteArray out(str + start, i - start);
         long last_escaped_codepoint = -1;
         while (true) {
-            if (i == str.size())
+            if (i == size)
                 return fail("unexpected end of input in QString", "");
 
-            char ch = str[i++].unicode();
+            char ch = str[i++];
 
             if (ch == '"') {
                 encode_utf8(last_escaped_codepoint, out);
-                return out;
+                return QString::fromUtf8(out);
             }
 
-            if (in_range(ch, 0, 0x1f))
+            if (in_range(static_cast<uint8_t>(ch), 0, 0x1f))
                 return fail(QString("unescaped " + esc(ch) + " in QString"), QString());
 
             // The usual case: non-escaped characters
@@ -543,24 +634,21 @@ struct JsonParser final {
             }
 
             // Handle escapes
-            if (i == str.size())
+            if (i == size)
                 return fail("unexpected end of input in QString", "");
 
-            ch = str[i++].unicode();
+            ch = str[i++];
 
             if (ch == 'u') {
                 // Extract 4-byte escape sequence
-                QString esc = str.right(i).left(4);
-                // Explicitly check length of the substring. The following loop
-                // relies on std::QString returning the terminating NUL when
-                // accessing str[length]. Checking here reduces brittleness.
+                const QByteArray esc = QByteArray(str + i, qMin(4, size - i));
                 if (esc.length() < 4) {
-                    return fail(QString("bad \\u escape: " + esc), "");
+                    return fail(QString("bad \\u escape: " + QString::fromUtf8(esc)), "");
                 }
                 for (unsigned j = 0; j < 4; j++) {
-                    if (!in_range(esc[j].unicode(), 'a', 'f') && !in_range(esc[j].unicode(), 'A', 'F')
-                            && !in_range(esc[j].unicode(), '0', '9'))
-                        return fail(QString("bad \\u escape: " + esc), "");
+                    if (!in_range(esc[j], 'a', 'f') && !in_range(esc[j], 'A', 'F')
+                            && !in_range(esc[j], '0', '9'))
+                        return fail(QString("bad \\u escape: " + QString::fromUtf8(esc)), "");
                 }
 
                 long codepoint = esc.toLong(nullptr, 16);
@@ -611,7 +699,7 @@ struct JsonParser final {
      * Parse a double.
      */
     Json parse_number() {
-        unsigned start_pos = i;
+        int start_pos = i;
 
         if (str[i] == '-')
             i++;
@@ -619,29 +707,29 @@ struct JsonParser final {
         // Integer part
         if (str[i] == '0') {
             i++;
-            if (in_range(str[i].unicode(), '0', '9'))
+            if (in_range(str[i], '0', '9'))
                 return fail("leading 0s not permitted in numbers");
-        } else if (in_range(str[i].unicode(), '1', '9')) {
+        } else if (in_range(str[i], '1', '9')) {
             i++;
-            while (in_range(str[i].unicode(), '0', '9'))
+            while (in_range(str[i], '0', '9'))
                 i++;
         } else {
-            return fail(QString("invalid " + esc(str[i].unicode()) + " in number"));
+            return fail(QString("invalid " + esc(str[i]) + " in number"));
         }
 
         if (str[i] != '.' && str[i] != 'e' && str[i] != 'E'
-                && (i - start_pos) <= static_cast<unsigned>(std::numeric_limits<int>::digits10)) {
+                && (i - start_pos) <= std::numeric_limits<int>::digits10) {
             bool ok;
-            return str.mid(start_pos, i - start_pos).toInt(&ok);
+            return QByteArray::fromRawData(str + start_pos, i - start_pos).toInt(&ok);
         }
 
         // Decimal part
         if (str[i] == '.') {
             i++;
-            if (!in_range(str[i].unicode(), '0', '9'))
+            if (!in_range(str[i], '0', '9'))
                 return fail("at least one digit required in fractional part");
 
-            while (in_range(str[i].unicode(), '0', '9'))
+            while (in_range(str[i], '0', '9'))
                 i++;
         }
 
@@ -652,15 +740,15 @@ struct JsonParser final {
             if (str[i] == '+' || str[i] == '-')
                 i++;
 
-            if (!in_range(str[i].unicode(), '0', '9'))
+            if (!in_range(str[i], '0', '9'))
                 return fail("at least one digit required in exponent");
 
-            while (in_range(str[i].unicode(), '0', '9'))
+            while (in_range(str[i], '0', '9'))
                 i++;
         }
 
         bool ok;
-        return str.mid(start_pos, i - start_pos).toDouble(&ok);
+        return QByteArray::fromRawData(str + start_pos, i - start_pos).toDouble(&ok);
     }
 
     /* expect(str, res)
@@ -668,15 +756,16 @@ struct JsonParser final {
      * Expect that 'str' starts at the character that was just read. If it does, advance
      * the input and return res. If not, flag an error.
      */
-    Json expect(const QString &expected, Json res) {
+    Json expect(const char *expected, Json res) {
         assert(i != 0);
         i--;
-        QString result = str.right(str.size() - i).left(expected.length());
-        if (result == expected) {
-            i += expected.length();
+        const int length = static_cast<int>(strlen(expected));
+        if (size - i >= length && strncmp(str + i, expected, length) == 0) {
+            i += length;
             return res;
         } else {
-            return fail(QString("parse error: expected " + expected + ", got " + str.right(i).left(expected.length())));
+            return fail(QString("parse error: expected %1, got %2").arg(expected)
+                        .arg(QString::fromUtf8(str + i, qMin(length, size - i))));
         }
     }
 
@@ -740,7 +829,7 @@ struct JsonParser final {
 
                 ch = get_next_token();
             }
-            return data;
+            return Json(std::move(data));
         }
 
         if (ch == '[') {
@@ -764,7 +853,7 @@ struct JsonParser final {
                 ch = get_next_token();
                 (void)ch;
             }
-            return data;
+            return Json(std::move(data));
         }
 
         return fail(QString("expected value, got " + esc(ch)));
@@ -772,18 +861,24 @@ struct JsonParser final {
 };
 }//namespace {
 
-Json Json::parse(const QString &in, QString &err, JsonParse strategy) {
-    JsonParser parser { in, 0, err, false, strategy };
+Json Json::parse(const QByteArray &in, QString &err, JsonParse strategy) {
+    // Skip the UTF-8 byte order mark that some editors add to the start of a file.
+    const int start = in.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+    JsonParser parser { in.constData(), static_cast<int>(in.size()), start, err, false, strategy };
     Json result = parser.parse_json(0);
 
     // Check for any trailing garbage
     parser.consume_garbage();
     if (parser.failed)
         return Json();
-    if (parser.i != in.size())
-        return parser.fail(QString("unexpected trailing " + esc(in[parser.i].unicode())));
+    if (parser.i != parser.size)
+        return parser.fail(QString("unexpected trailing " + esc(in[parser.i])));
 
     return result;
 }
 
+Json Json::parse(const QString &in, QString &err, JsonParse strategy) {
+    return parse(in.toUtf8(), err, strategy);
+}
+
 } // namespace poryjson
@@ -1,8 +1,13 @@
 #include "log.h"
 #include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
+#include <QMutex>
 #include <QStandardPaths>
 #include <QSysInfo>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
 
 // Enabling this does not seem to be simple to color console output
 // on Windows for all CLIs without external libraries or extreme bloat.
@@ -18,6 +23,14 @@
     #define CLEAR_COLOR   "\033[0m"
 #endif
 
+// When the log file grows past this size it's moved to a backup file, replacing any previous backup.
+static const qint64 maxLogFileSize = 20000000;
+
+static std::atomic<int> logLevel(LogType::LOG_INFO);
+
+static QMutex mostRecentErrorMutex;
+static QString mostRecentError;
+
 void logInfo(QString message) {
     log(message, LogType::LOG_INFO);
 }
@@ -26,10 +39,11 @@ void logWarn(QString message) {
     log(message, LogType::LOG_WARN);
 }
 
-static QString mostRecentError;
-
 void logError(QString message) {
-    mostRecentError = message;
+    {
+        QMutexLocker locker(&mostRecentErrorMutex);
+        mostRecentError = message;
+    }
     log(message, LogType::LOG_ERROR);
 }
 
@@ -50,29 +64,210 @@ QString colorizeMessage(QString message, LogType type) {
     return colorized;
 }
 
-void log(QString message, LogType type) {
-    QString now = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-    QString typeString = "";
-    switch (type)
-    {
-    case LogType::LOG_INFO:
-        typeString = " [INFO]";
-        break;
-    case LogType::LOG_WARN:
-        typeString = " [WARN]";
-        break;
-    case LogType::LOG_ERROR:
-        typeString = "[ERROR]";
-        break;
+namespace {
+
+struct LogEntry {
+    qint64 time;
+    LogType type;
+    QString message;
+};
+
+// Messages are formatted and written to the console and the log file by a background thread,
+// so logging a message only costs the caller a short lock to queue it.
+// The log file is kept open, and all the messages queued since the last write are written together.
+class LogWriter {
+public:
+    ~LogWriter() {
+        stop();
+    }
+
+    void start(const QString &path) {
+        QMutexLocker locker(&this->mutex);
+        if (this->thread)
+            return;
+        this->path = path;
+        this->thread = QThread::create([this] { this->run(); });
+        this->thread->start(QThread::LowPriority);
+    }
+
+    void stop() {
+        QThread *thread;
+        {
+            QMutexLocker locker(&this->mutex);
+            this->stopping = true;
+            this->condition.wakeAll();
+            thread = this->thread;
+        }
+        if (thread)
+            thread->wait();
+
+        // Anything logged while the writing thread was exiting is written here, and anything logged after this is written immediately.
+        QMutexLocker locker(&this->mutex);
+        this->thread = nullptr;
+        this->stopped = true;
+        if (!thread && this->path.isEmpty() && QCoreApplication::instance()) {
+            // The writer was never started, write anything that was logged.
+            this->path = getLogPath();
+        }
+        if (!this->pending.isEmpty() && !this->path.isEmpty())
+            this->write(this->pending);
+        this->numWritten += this->pending.length();
+        this->pending.clear();
+        this->writtenCondition.wakeAll();
+        locker.unlock();
+        delete thread;
+    }
+
+    void enqueue(LogEntry entry) {
+        QMutexLocker locker(&this->mutex);
+        if (this->stopped) {
+            if (!this->path.isEmpty())
+                this->write({entry});
+            return;
+        }
+        this->pending.append(std::move(entry));
+        this->numQueued++;
+        this->condition.wakeAll();
+    }
+
+    // Waits until every message queued so far has been written, so that they aren't lost if porymap crashes.
+    void flush() {
+        QMutexLocker locker(&this->mutex);
+        if (!this->thread || this->stopping || this->stopped || QThread::currentThread() == this->thread)
+            return;
+        const qint64 target = this->numQueued;
+        while (this->numWritten < target && !this->stopped)
+            this->writtenCondition.wait(&this->mutex);
     }
 
-    message = QString("%1 %2 %3").arg(now).arg(typeString).arg(message);
+private:
+    void run() {
+        QList<LogEntry> entries;
+        while (true) {
+            {
+                QMutexLocker locker(&this->mutex);
+                while (this->pending.isEmpty() && !this->stopping)
+                    this->condition.wait(&this->mutex);
+                entries.swap(this->pending);
+                if (entries.isEmpty() && this->stopping)
+                    return;
+            }
+            this->write(entries);
+            {
+                QMutexLocker locker(&this->mutex);
+                this->numWritten += entries.length();
+                this->writtenCondition.wakeAll();
+            }
+            entries.clear();
+        }
+    }
+
+    void write(const QList<LogEntry> &entries) {
+        if (!this->file.isOpen())
+            this->openFile();
+
+        QByteArray data;
+        for (const LogEntry &entry : entries) {
+            const QString message = QString("%1 %2 %3").arg(this->timestamp(entry.time))
+                                                        .arg(typeString(entry.type))
+                                                        .arg(entry.message);
+            qDebug().noquote() << colorizeMessage(message, entry.type);
+            data.append(message.toUtf8());
+            data.append('\n');
+        }
+
+        if (this->file.isOpen()) {
+            this->file.write(data);
+            this->file.flush();
+            if (this->file.size() >= maxLogFileSize)
+                this->rotateFile();
+        }
+    }
+
+    void openFile() {
+        QFileInfo info(this->path);
+        if (info.exists() && info.size() >= maxLogFileSize)
+            this->rotateFile();
+        this->file.setFileName(this->path);
+        this->file.open(QIODevice::WriteOnly | QIODevice::Append);
+    }
+
+    void rotateFile() {
+        this->file.close();
+        const QString backupPath = this->path + ".1";
+        QFile::remove(backupPath);
+        QFile::rename(this->path, backupPath);
+        this->file.setFileName(this->path);
+        this->file.open(QIODevice::WriteOnly | QIODevice::Append);
+    }
+
+    // Formatting the date is comparatively slow, and many messages are logged within the same second.
+    QString timestamp(qint64 time) {
+        const qint64 seconds = time / 1000;
+        if (seconds != this->lastTimestampSeconds) {
+            this->lastTimestampSeconds = seconds;
+            this->lastTimestamp = QDateTime::fromMSecsSinceEpoch(time).toString("yyyy-MM-dd HH:mm:ss");
+        }
+        return this->lastTimestamp;
+    }
+
+    static QString typeString(LogType type) {
+        switch (type)
+        {
+        case LogType::LOG_INFO:
+            return " [INFO]";
+        case LogType::LOG_WARN:
+            return " [WARN]";
+        case LogType::LOG_ERROR:
+            return "[ERROR]";
+        }
+        return QString();
+    }
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QWaitCondition writtenCondition;
+    QList<LogEntry> pending;
+    qint64 numQueued = 0;
+    qint64 numWritten = 0;
+    bool stopping = false;
+    bool stopped = false;
+    QThread *thread = nullptr;
 
-    qDebug().noquote() << colorizeMessage(message, type);
-    QFile outFile(getLogPath());
-    outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-    QTextStream ts(&outFile);
-    ts << message << Qt::endl;
+    // Only used by the writing thread, or while holding the mutex once it has stopped
+    QString path;
+    QFile file;
+    qint64 lastTimestampSeconds = -1;
+    QString lastTimestamp;
+};
+
+LogWriter &logWriter() {
+    static LogWriter writer;
+    return writer;
+}
+
+} // namespace
+
+void log(QString message, LogType type) {
+    if (!logLevelEnabled(type))
+        return;
+    logWriter().enqueue({QDateTime::currentMSecsSinceEpoch(), type, message});
+    if (type == LogType::LOG_ERROR)
+        logWriter().flush();
+}
+
+// Starts writing log messages to the log file. Any messages logged before this are written once it's called.
+// This should be called after the application name has been set, because it determines the log file's location.
+void logInit() {
+    logWriter().start(getLogPath());
+}
+
+void setLogLevel(LogType type) {
+    logLevel = type;
+}
+
+bool logLevelEnabled(LogType type) {
+    return type <= logLevel;
 }
 
 QString getLogPath() {
@@ -84,16 +279,6 @@ QString getLogPath() {
 }
 
 QString getMostRecentError() {
+    QMutexLocker locker(&mostRecentErrorMutex);
     return mostRecentError;
 }
-
-bool cleanupLargeLog() {
-    QFile logFile(getLogPath());
-    if (logFile.size() < 20000000)
-        return false;
-
-    bool removed = logFile.remove();
-    if (removed)
-        logWarn(QString("Previous log file %1 was cleared due to being over 20MB in size.").arg(getLogPath()));
-    return removed;
-}
@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "profiling.h"
 #include <QApplication>
 
 int main(int argc, char *argv[])
@@ -6,8 +7,11 @@ int main(int argc, char *argv[])
     QGuiApplication::setHighDpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy::Round);
     QApplication a(argc, argv);
     a.setStyle("fusion");
+    Profiling::init();
     MainWindow w(nullptr);
     w.show();
 
-    return a.exec();
+    int result = a.exec();
+    Profiling::finish();
+    return result;
 }
@@ -3,6 +3,7 @@
 #include "aboutporymap.h"
 #include "project.h"
 #include "log.h"
+#include "profiling.h"
 #include "editor.h"
 #include "prefabcreationdialog.h"
 #include "eventframes.h"
@@ -57,7 +58,7 @@ MainWindow::MainWindow(QWidget *parent) :
     QApplication::setWindowIcon(QIcon(":/icons/porymap-icon-2.ico"));
     ui->setupUi(this);
 
-    cleanupLargeLog();
+    logInit();
 
     this->initWindow();
     if (porymapConfig.getReopenOnLaunch() && this->openProject(porymapConfig.getRecentProject(), true))
@@ -97,6 +98,7 @@ void MainWindow::setWindowDisabled(bool disabled) {
 
 void MainWindow::initWindow() {
     porymapConfig.load();
+    setLogLevel(porymapConfig.getLogLevel());
     this->initCustomUI();
     this->initExtraSignals();
     this->initEditor();
@@ -304,16 +306,10 @@ void MainWindow::initEditor() {
 }
 
 void MainWindow::initMiscHeapObjects() {
-    mapIcon = new QIcon(QStringLiteral(":/icons/map.ico"));
-    mapEditedIcon = new QIcon(QStringLiteral(":/icons/map_edited.ico"));
-    mapOpenedIcon = new QIcon(QStringLiteral(":/icons/map_opened.ico"));
-
-    mapListModel = new QStandardItemModel;
-    mapGroupItemsList = new QList<QStandardItem*>;
-    mapListProxyModel = new FilterChildrenProxyModel;
-
-    mapListProxyModel->setSourceModel(mapListModel);
+    mapListModel = new MapListModel(this);
+    mapListProxyModel = new MapListProxyModel(mapListModel, this);
     ui->mapList->setModel(mapListProxyModel);
+    mapPrefetcher = new MapPrefetcher(this);
 
     eventTabObjectWidget = ui->tab_Objects;
     eventTabWarpWidget = ui->tab_Warps;
@@ -422,14 +418,17 @@ void MainWindow::on_lineEdit_filterBox_textChanged(const QString &arg1)
 
 void MainWindow::applyMapListFilter(QString filterText)
 {
-    mapListProxyModel->setFilterRegularExpression(QRegularExpression(filterText, QRegularExpression::CaseInsensitiveOption));
+    ui->mapList->setUpdatesEnabled(false);
+    mapListProxyModel->setFilterText(filterText);
     if (filterText.isEmpty()) {
         ui->mapList->collapseAll();
     } else {
         ui->mapList->expandToDepth(0);
     }
-    ui->mapList->setExpanded(mapListProxyModel->mapFromSource(mapListIndexes.value(editor->map->name)), true);
-    ui->mapList->scrollTo(mapListProxyModel->mapFromSource(mapListIndexes.value(editor->map->name)), QAbstractItemView::PositionAtCenter);
+    ui->mapList->setUpdatesEnabled(true);
+    const QModelIndex index = mapListProxyModel->mapFromSource(mapListModel->indexOfMap(editor->map->name));
+    ui->mapList->setExpanded(index, true);
+    ui->mapList->scrollTo(index, QAbstractItemView::PositionAtCenter);
 }
 
 void MainWindow::loadUserSettings() {
@@ -477,6 +476,7 @@ void MainWindow::setTheme(QString theme) {
 }
 
 bool MainWindow::openProject(const QString &dir, bool initial) {
+    PROFILE_SCOPE("MainWindow::openProject");
     if (dir.isNull() || dir.length() <= 0) {
         projectOpenFailure = true;
         if (!initial) setWindowDisabled(true);
@@ -510,6 +510,7 @@ bool MainWindow::openProject(const QString &dir, bool initial) {
 
     this->closeSupplementaryWindows();
     this->newMapDefaultsSet = false;
+    this->mapPrefetcher->cancel();
 
     if (isProjectOpen())
         Scripting::cb_ProjectClosed(editor->project->root);
@@ -521,6 +522,7 @@ bool MainWindow::openProject(const QString &dir, bool initial) {
         editor->project = new Project(this);
         QObject::connect(editor->project, &Project::reloadProject, this, &MainWindow::on_action_Reload_Project_triggered);
         QObject::connect(editor->project, &Project::mapCacheCleared, this, &MainWindow::onMapCacheCleared);
+        QObject::connect(editor->project, &Project::dataReloaded, this, &MainWindow::onProjectDataReloaded);
         QObject::connect(editor->project, &Project::uncheckMonitorFilesAction, [this]() {
             porymapConfig.setMonitorFiles(false);
             if (this->preferenceEditor)
@@ -528,7 +530,7 @@ bool MainWindow::openProject(const QString &dir, bool initial) {
         });
         editor->project->set_root(dir);
     } else {
-        editor->project->fileWatcher.removePaths(editor->project->fileWatcher.files());
+        editor->project->stopWatchingFiles();
         editor->project->clearMapCache();
         editor->project->clearTilesetCache();
     }
@@ -668,6 +670,7 @@ void MainWindow::on_action_Reload_Project_triggered() {
 }
 
 bool MainWindow::setMap(QString map_name, bool scrollTreeView) {
+    PROFILE_SCOPE("MainWindow::setMap");
     logInfo(QString("Setting map to '%1'").arg(map_name));
     if (map_name.isEmpty()) {
         return false;
@@ -679,7 +682,7 @@ bool MainWindow::setMap(QString map_name, bool scrollTreeView) {
     }
 
     if (editor->map != nullptr && !editor->map->name.isNull()) {
-        ui->mapList->setExpanded(mapListProxyModel->mapFromSource(mapListIndexes.value(editor->map->name)), false);
+        ui->mapList->setExpanded(mapListProxyModel->mapFromSource(mapListModel->indexOfMap(editor->map->name)), false);
     }
 
     this->lastSelectedEvent.clear();
@@ -688,12 +691,12 @@ bool MainWindow::setMap(QString map_name, bool scrollTreeView) {
 
     if (scrollTreeView) {
         // Make sure we clear the filter first so we actually have a scroll target
-        mapListProxyModel->setFilterRegularExpression(QString());
-        ui->mapList->setCurrentIndex(mapListProxyModel->mapFromSource(mapListIndexes.value(map_name)));
+        mapListProxyModel->setFilterText(QString());
+        ui->mapList->setCurrentIndex(mapListProxyModel->mapFromSource(mapListModel->indexOfMap(map_name)));
         ui->mapList->scrollTo(ui->mapList->currentIndex(), QAbstractItemView::PositionAtCenter);
     }
 
-    ui->mapList->setExpanded(mapListProxyModel->mapFromSource(mapListIndexes.value(map_name)), true);
+    ui->mapList->setExpanded(mapListProxyModel->mapFromSource(mapListModel->indexOfMap(map_name)), true);
 
     showWindowTitle();
 
@@ -707,9 +710,26 @@ bool MainWindow::setMap(QString map_name, bool scrollTreeView) {
     Scripting::cb_MapOpened(map_name);
     prefab.updatePrefabUi(editor->map);
     updateTilesetEditor();
+    prefetchMaps();
     return true;
 }
 
+// Prefetch the maps that are likely to be opened from this one: its connections, its warp destinations,
+// and the maps next to it in the map list.
+void MainWindow::prefetchMaps() {
+    QStringList mapNames;
+    for (MapConnection *connection : editor->map->connections)
+        mapNames.append(connection->map_name);
+    for (Event *event : editor->map->events.value(Event::Group::Warp)) {
+        WarpEvent *warp = dynamic_cast<WarpEvent *>(event);
+        if (warp)
+            mapNames.append(warp->getDestinationMap());
+    }
+    mapNames.append(mapListModel->getAdjacentMaps(editor->map->name));
+    mapNames.removeAll(editor->map->name);
+    mapPrefetcher->prefetch(editor->project, mapNames);
+}
+
 void MainWindow::redrawMapScene()
 {
     if (!editor->displayMap())
@@ -986,150 +1006,34 @@ bool MainWindow::loadProjectCombos() {
     const QSignalBlocker blocker6(ui->comboBox_BattleScene);
     const QSignalBlocker blocker7(ui->comboBox_Type);
 
-    ui->comboBox_Song->clear();
-    ui->comboBox_Song->addItems(project->songNames);
-    ui->comboBox_Location->clear();
-    ui->comboBox_Location->addItems(project->mapSectionValueToName.values());
-    ui->comboBox_PrimaryTileset->clear();
-    ui->comboBox_PrimaryTileset->addItems(project->primaryTilesetLabels);
-    ui->comboBox_SecondaryTileset->clear();
-    ui->comboBox_SecondaryTileset->addItems(project->secondaryTilesetLabels);
-    ui->comboBox_Weather->clear();
-    ui->comboBox_Weather->addItems(project->weatherNames);
-    ui->comboBox_BattleScene->clear();
-    ui->comboBox_BattleScene->addItems(project->mapBattleScenes);
-    ui->comboBox_Type->clear();
-    ui->comboBox_Type->addItems(project->mapTypes);
+    ui->comboBox_Song->setSharedModel(project->getListModel("songNames", project->songNames));
+    ui->comboBox_Location->setSharedModel(project->getListModel("mapSections", project->mapSectionValueToName.values()));
+    ui->comboBox_PrimaryTileset->setSharedModel(project->getListModel("primaryTilesetLabels", project->primaryTilesetLabels));
+    ui->comboBox_SecondaryTileset->setSharedModel(project->getListModel("secondaryTilesetLabels", project->secondaryTilesetLabels));
+    ui->comboBox_Weather->setSharedModel(project->getListModel("weatherNames", project->weatherNames));
+    ui->comboBox_BattleScene->setSharedModel(project->getListModel("mapBattleScenes", project->mapBattleScenes));
+    ui->comboBox_Type->setSharedModel(project->getListModel("mapTypes", project->mapTypes));
 
     return true;
 }
 
 bool MainWindow::populateMapList() {
-    bool success = editor->project->readMapGroups();
+    bool success = editor->project->readMapGroups()
+                && editor->project->readMapHeaders();
     if (success) {
+        mapListModel->setProject(editor->project);
         sortMapList();
     }
     return success;
 }
 
 void MainWindow::sortMapList() {
-    Project *project = editor->project;
-
-    QIcon mapFolderIcon;
-    mapFolderIcon.addFile(QStringLiteral(":/icons/folder_closed_map.ico"), QSize(), QIcon::Normal, QIcon::Off);
-    mapFolderIcon.addFile(QStringLiteral(":/icons/folder_map.ico"), QSize(), QIcon::Normal, QIcon::On);
-
-    QIcon folderIcon;
-    folderIcon.addFile(QStringLiteral(":/icons/folder_closed.ico"), QSize(), QIcon::Normal, QIcon::Off);
-    //folderIcon.addFile(QStringLiteral(":/icons/folder.ico"), QSize(), QIcon::Normal, QIcon::On);
-
     ui->mapList->setUpdatesEnabled(false);
-    mapListModel->clear();
-    mapGroupItemsList->clear();
-    QStandardItem *root = mapListModel->invisibleRootItem();
-
-    switch (mapSortOrder)
-    {
-        case MapSortOrder::Group:
-            for (int i = 0; i < project->groupNames.length(); i++) {
-                QString group_name = project->groupNames.value(i);
-                QStandardItem *group = new QStandardItem;
-                group->setText(group_name);
-                group->setIcon(mapFolderIcon);
-                group->setEditable(false);
-                group->setData(group_name, Qt::UserRole);
-                group->setData("map_group", MapListUserRoles::TypeRole);
-                group->setData(i, MapListUserRoles::GroupRole);
-                root->appendRow(group);
-                mapGroupItemsList->append(group);
-                QStringList names = project->groupedMapNames.value(i);
-                for (int j = 0; j < names.length(); j++) {
-                    QString map_name = names.value(j);
-                    QStandardItem *map = createMapItem(map_name, i, j);
-                    group->appendRow(map);
-                    mapListIndexes.insert(map_name, map->index());
-                }
-            }
-            break;
-        case MapSortOrder::Area:
-        {
-            QMap<QString, int> mapsecToGroupNum;
-            for (int i = 0; i < project->mapSectionNameToValue.size(); i++) {
-                QString mapsec_name = project->mapSectionValueToName.value(i);
-                QStandardItem *mapsec = new QStandardItem;
-                mapsec->setText(mapsec_name);
-                mapsec->setIcon(folderIcon);
-                mapsec->setEditable(false);
-                mapsec->setData(mapsec_name, Qt::UserRole);
-                mapsec->setData("map_sec", MapListUserRoles::TypeRole);
-                mapsec->setData(i, MapListUserRoles::GroupRole);
-                root->appendRow(mapsec);
-                mapGroupItemsList->append(mapsec);
-                mapsecToGroupNum.insert(mapsec_name, i);
-            }
-            for (int i = 0; i < project->groupNames.length(); i++) {
-                QStringList names = project->groupedMapNames.value(i);
-                for (int j = 0; j < names.length(); j++) {
-                    QString map_name = names.value(j);
-                    QStandardItem *map = createMapItem(map_name, i, j);
-                    QString location = project->readMapLocation(map_name);
-                    QStandardItem *mapsecItem = mapGroupItemsList->at(mapsecToGroupNum[location]);
-                    mapsecItem->setIcon(mapFolderIcon);
-                    mapsecItem->appendRow(map);
-                    mapListIndexes.insert(map_name, map->index());
-                }
-            }
-            break;
-        }
-        case MapSortOrder::Layout:
-        {
-            QMap<QString, int> layoutIndices;
-            for (int i = 0; i < project->mapLayoutsTable.length(); i++) {
-                QString layoutId = project->mapLayoutsTable.value(i);
-                MapLayout *layout = project->mapLayouts.value(layoutId);
-                QStandardItem *layoutItem = new QStandardItem;
-                layoutItem->setText(layout->name);
-                layoutItem->setIcon(folderIcon);
-                layoutItem->setEditable(false);
-                layoutItem->setData(layout->name, Qt::UserRole);
-                layoutItem->setData("map_layout", MapListUserRoles::TypeRole);
-                layoutItem->setData(layout->id, MapListUserRoles::TypeRole2);
-                layoutItem->setData(i, MapListUserRoles::GroupRole);
-                root->appendRow(layoutItem);
-                mapGroupItemsList->append(layoutItem);
-                layoutIndices[layoutId] = i;
-            }
-            for (int i = 0; i < project->groupNames.length(); i++) {
-                QStringList names = project->groupedMapNames.value(i);
-                for (int j = 0; j < names.length(); j++) {
-                    QString map_name = names.value(j);
-                    QStandardItem *map = createMapItem(map_name, i, j);
-                    QString layoutId = project->readMapLayoutId(map_name);
-                    QStandardItem *layoutItem = mapGroupItemsList->at(layoutIndices.value(layoutId));
-                    layoutItem->setIcon(mapFolderIcon);
-                    layoutItem->appendRow(map);
-                    mapListIndexes.insert(map_name, map->index());
-                }
-            }
-            break;
-        }
-    }
-
+    mapListModel->setSortOrder(mapSortOrder);
     ui->mapList->setUpdatesEnabled(true);
-    ui->mapList->repaint();
     updateMapList();
 }
 
-QStandardItem* MainWindow::createMapItem(QString mapName, int groupNum, int inGroupNum) {
-    QStandardItem *map = new QStandardItem;
-    map->setText(QString("[%1.%2] ").arg(groupNum).arg(inGroupNum, 2, 10, QLatin1Char('0')) + mapName);
-    map->setIcon(*mapIcon);
-    map->setEditable(false);
-    map->setData(mapName, Qt::UserRole);
-    map->setData("map_name", MapListUserRoles::TypeRole);
-    return map;
-}
-
 void MainWindow::onOpenMapListContextMenu(const QPoint &point)
 {
     QModelIndex index = mapListProxyModel->mapToSource(ui->mapList->indexAt(point));
@@ -1137,30 +1041,29 @@ void MainWindow::onOpenMapListContextMenu(const QPoint &point)
         return;
     }
 
-    QStandardItem *selectedItem = mapListModel->itemFromIndex(index);
-    QVariant itemType = selectedItem->data(MapListUserRoles::TypeRole);
+    QVariant itemType = index.data(MapListUserRoles::TypeRole);
     if (!itemType.isValid()) {
         return;
     }
 
     // Build custom context menu depending on which type of item was selected (map group, map name, etc.)
     if (itemType == "map_group") {
-        QString groupName = selectedItem->data(Qt::UserRole).toString();
-        int groupNum = selectedItem->data(MapListUserRoles::GroupRole).toInt();
+        QString groupName = index.data(Qt::UserRole).toString();
+        int groupNum = index.data(MapListUserRoles::GroupRole).toInt();
         QMenu* menu = new QMenu(this);
         QActionGroup* actions = new QActionGroup(menu);
         actions->addAction(menu->addAction("Add New Map to Group"))->setData(groupNum);
         connect(actions, &QActionGroup::triggered, this, &MainWindow::onAddNewMapToGroupClick);
         menu->exec(QCursor::pos());
     } else if (itemType == "map_sec") {
-        QString secName = selectedItem->data(Qt::UserRole).toString();
+        QString secName = index.data(Qt::UserRole).toString();
         QMenu* menu = new QMenu(this);
         QActionGroup* actions = new QActionGroup(menu);
         actions->addAction(menu->addAction("Add New Map to Area"))->setData(secName);
         connect(actions, &QActionGroup::triggered, this, &MainWindow::onAddNewMapToAreaClick);
         menu->exec(QCursor::pos());
     } else if (itemType == "map_layout") {
-        QString layoutId = selectedItem->data(MapListUserRoles::TypeRole2).toString();
+        QString layoutId = index.data(MapListUserRoles::TypeRole2).toString();
         QMenu* menu = new QMenu(this);
         QActionGroup* actions = new QActionGroup(menu);
         actions->addAction(menu->addAction("Add New Map with Layout"))->setData(layoutId);
@@ -1201,13 +1104,7 @@ void MainWindow::onNewMapCreated() {
     editor->project->saveMap(newMap);
     editor->project->saveAllDataStructures();
 
-    QStandardItem* groupItem = mapGroupItemsList->at(newMapGroup);
-    int numMapsInGroup = groupItem->rowCount();
-
-    QStandardItem *newMapItem = createMapItem(newMapName, newMapGroup, numMapsInGroup);
-    groupItem->appendRow(newMapItem);
-    mapListIndexes.insert(newMapName, newMapItem->index());
-
+    mapListModel->setProject(editor->project);
     sortMapList();
     setMap(newMapName, true);
 
@@ -1337,12 +1234,23 @@ void MainWindow::on_actionNew_Tileset_triggered() {
         newSet.appendToGraphics(editor->project->root, createTilesetDialog->friendlyName, editor->project->usingAsmTilesets);
         newSet.appendToMetatiles(editor->project->root, createTilesetDialog->friendlyName, editor->project->usingAsmTilesets);
 
+        // The tileset combo boxes list the project's shared models, so they're given the updated model.
+        NoScrollComboBox *tilesetCombo;
+        ConstantListModel *tilesetModel;
         if (!createTilesetDialog->isSecondary) {
-            int index = insertTilesetLabel(&editor->project->primaryTilesetLabels, createTilesetDialog->fullSymbolName);
-            this->ui->comboBox_PrimaryTileset->insertItem(index, createTilesetDialog->fullSymbolName);
+            insertTilesetLabel(&editor->project->primaryTilesetLabels, createTilesetDialog->fullSymbolName);
+            tilesetCombo = this->ui->comboBox_PrimaryTileset;
+            tilesetModel = editor->project->getListModel("primaryTilesetLabels", editor->project->primaryTilesetLabels);
         } else {
-            int index = insertTilesetLabel(&editor->project->secondaryTilesetLabels, createTilesetDialog->fullSymbolName);
-            this->ui->comboBox_SecondaryTileset->insertItem(index, createTilesetDialog->fullSymbolName);
+            insertTilesetLabel(&editor->project->secondaryTilesetLabels, createTilesetDialog->fullSymbolName);
+            tilesetCombo = this->ui->comboBox_SecondaryTileset;
+            tilesetModel = editor->project->getListModel("secondaryTilesetLabels", editor->project->secondaryTilesetLabels);
+        }
+        {
+            const QSignalBlocker blocker(tilesetCombo);
+            const QString currentTileset = tilesetCombo->currentText();
+            tilesetCombo->setSharedModel(tilesetModel);
+            tilesetCombo->setTextItem(currentTileset);
         }
         insertTilesetLabel(&editor->project->tilesetLabelsOrdered, createTilesetDialog->fullSymbolName);
 
@@ -1409,38 +1317,18 @@ void MainWindow::on_mapList_activated(const QModelIndex &index)
     }
 }
 
-void MainWindow::drawMapListIcons(QAbstractItemModel *model) {
+void MainWindow::updateMapList() {
     projectHasUnsavedChanges = false;
-    QList<QModelIndex> list;
-    list.append(QModelIndex());
-    while (list.length()) {
-        QModelIndex parent = list.takeFirst();
-        for (int i = 0; i < model->rowCount(parent); i++) {
-            QModelIndex index = model->index(i, 0, parent);
-            if (model->hasChildren(index)) {
-                list.append(index);
-            }
-            QVariant data = index.data(Qt::UserRole);
-            if (!data.isNull()) {
-                QString map_name = data.toString();
-                if (editor->project && editor->project->mapCache.contains(map_name)) {
-                    QStandardItem *map = mapListModel->itemFromIndex(mapListIndexes.value(map_name));
-                    map->setIcon(*mapIcon);
-                    if (editor->project->mapCache.value(map_name)->hasUnsavedChanges()) {
-                        map->setIcon(*mapEditedIcon);
-                        projectHasUnsavedChanges = true;
-                    }
-                    if (editor->map->name == map_name) {
-                        map->setIcon(*mapOpenedIcon);
-                    }
-                }
+    if (editor->project) {
+        for (Map *map : editor->project->mapCache) {
+            if (map->hasUnsavedChanges()) {
+                projectHasUnsavedChanges = true;
+                break;
             }
         }
     }
-}
-
-void MainWindow::updateMapList() {
-    drawMapListIcons(mapListModel);
+    mapListModel->setOpenMap(editor->map ? editor->map->name : QString());
+    mapListModel->updateMapIcons();
 }
 
 void MainWindow::on_action_Save_Project_triggered() {
@@ -2373,6 +2261,19 @@ void MainWindow::onMapCacheCleared() {
     editor->map = nullptr;
 }
 
+// Some of the project's data was reloaded because its files changed on disk. Refresh the UI that displays it.
+void MainWindow::onProjectDataReloaded() {
+    loadProjectCombos();
+    displayMapProperties();
+
+    // Event frames are only populated with the project's data when they're created, so recreate them.
+    for (Map *map : editor->project->mapCache.values()) {
+        for (Event *event : map->getAllEvents())
+            event->destroyEventFrame();
+    }
+    updateSelectedObjects();
+}
+
 void MainWindow::onTilesetsSaved(QString primaryTilesetLabel, QString secondaryTilesetLabel) {
     // If saved tilesets are currently in-use, update them and redraw
     // Otherwise overwrite the cache for the saved tileset
@@ -1,25 +1,32 @@
 #include "project.h"
 #include "config.h"
+#include "fileutil.h"
 #include "history.h"
 #include "log.h"
 #include "parseutil.h"
 #include "paletteutil.h"
+#include "profiling.h"
 #include "tile.h"
 #include "tileset.h"
 #include "map.h"
 
 #include "orderedjson.h"
 
+#include <QBuffer>
 #include <QDir>
+#include <QDirIterator>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QFile>
+#include <QImageReader>
 #include <QTextStream>
 #include <QStandardItem>
 #include <QMessageBox>
 #include <QRegularExpression>
+#include <QtConcurrent>
+#include <QFutureWatcher>
 #include <algorithm>
 
 using OrderedJson = poryjson::Json;
@@ -48,41 +55,129 @@ Project::~Project()
 
 void Project::initSignals() {
     // detect changes to specific filepaths being monitored
-    QObject::connect(&fileWatcher, &QFileSystemWatcher::fileChanged, [this](QString changed){
-        if (!porymapConfig.getMonitorFiles()) return;
-        if (modifiedFileTimestamps.contains(changed)) {
-            if (QDateTime::currentMSecsSinceEpoch() < modifiedFileTimestamps[changed]) {
-                return;
+    QObject::connect(&fileWatcher, &QFileSystemWatcher::fileChanged, [this](const QString &changed){
+        this->recordWatchedFileChange(changed);
+    });
+
+    // Changes are handled in batches, because a single external action (e.g. a build or a git checkout)
+    // will often touch many of the watched files at once.
+    fileChangeTimer.setSingleShot(true);
+    fileChangeTimer.setInterval(500);
+    QObject::connect(&fileChangeTimer, &QTimer::timeout, [this](){
+        this->processWatchedFileChanges();
+    });
+}
+
+// Watch the given file for changes. If only some of the project's data depends on this file, 'reader'
+// should be the function that reads that data, which will be called to reload it if the file changes.
+// If no function is given then changes to the file require reloading the full project.
+void Project::watchFile(const QString &filepath, ReadFunction reader) {
+    fileWatcher.addPath(filepath);
+    QList<ReadFunction> &readers = watchedFileReaders[filepath];
+    if (!readers.contains(reader))
+        readers.append(reader);
+    if (!watchedFileHashes.contains(filepath))
+        watchedFileHashes.insert(filepath, FileUtil::hash(filepath));
+}
+
+void Project::stopWatchingFiles() {
+    if (!fileWatcher.files().isEmpty())
+        fileWatcher.removePaths(fileWatcher.files());
+    watchedFileReaders.clear();
+    watchedFileHashes.clear();
+    changedFiles.clear();
+    fileChangeTimer.stop();
+}
+
+void Project::recordWatchedFileChange(const QString &filepath) {
+    // Files are often saved by writing a new file and replacing the old one, which stops the path from being watched.
+    if (!fileWatcher.files().contains(filepath) && QFileInfo::exists(filepath))
+        fileWatcher.addPath(filepath);
+
+    if (!porymapConfig.getMonitorFiles()) return;
+    if (modifiedFileTimestamps.contains(filepath)) {
+        if (QDateTime::currentMSecsSinceEpoch() < modifiedFileTimestamps[filepath]) {
+            // This is a file Porymap just wrote. Remember its new contents so they aren't mistaken for an outside change.
+            watchedFileHashes.insert(filepath, FileUtil::hash(filepath));
+            return;
+        }
+        modifiedFileTimestamps.remove(filepath);
+    }
+
+    changedFiles.insert(filepath);
+    fileChangeTimer.start();
+}
+
+void Project::processWatchedFileChanges() {
+    // Collect the files whose contents actually changed, and the data that needs to be reloaded as a result.
+    QStringList changed;
+    QList<ReadFunction> readers;
+    for (const QString &filepath : changedFiles) {
+        QByteArray hash = FileUtil::hash(filepath);
+        if (hash == watchedFileHashes.value(filepath))
+            continue;
+        watchedFileHashes.insert(filepath, hash);
+        changed.append(filepath);
+        for (ReadFunction reader : watchedFileReaders.value(filepath)) {
+            if (!readers.contains(reader))
+                readers.append(reader);
+        }
+    }
+    changedFiles.clear();
+    if (changed.isEmpty())
+        return;
+
+    // Reload only the affected data, if possible. Otherwise ask to reload the full project.
+    bool success = !readers.contains(nullptr);
+    for (int i = 0; success && i < readers.length(); i++)
+        success = (this->*readers.at(i))();
+
+    if (success) {
+        if (readers.contains(&Project::readTilesetMetatileLabels)) {
+            for (Tileset *tileset : tilesetCache.values()) {
+                if (tileset) loadTilesetMetatileLabels(tileset);
             }
-            modifiedFileTimestamps.remove(changed);
         }
+        for (const QString &filepath : changed)
+            logInfo(QString("Reloaded data from changed file '%1'").arg(QString(filepath).remove(this->root + "/")));
+        emit dataReloaded();
+        return;
+    }
+
+    static bool showing = false;
+    if (showing) return;
 
-        static bool showing = false;
-        if (showing) return;
+    for (QString &filepath : changed)
+        filepath.remove(this->root + "/");
 
-        QMessageBox notice(this->parentWidget());
-        notice.setText("File Changed");
+    QMessageBox notice(this->parentWidget());
+    notice.setText("File Changed");
+    if (changed.length() == 1) {
         notice.setInformativeText(QString("The file %1 has changed on disk. Would you like to reload the project?")
-                                  .arg(changed.remove(this->root + "/")));
-        notice.setStandardButtons(QMessageBox::No | QMessageBox::Yes);
-        notice.setDefaultButton(QMessageBox::No);
-        notice.setIcon(QMessageBox::Question);
-
-        QCheckBox showAgainCheck("Do not ask again.");
-        notice.setCheckBox(&showAgainCheck);
-
-        showing = true;
-        int choice = notice.exec();
-        if (choice == QMessageBox::Yes) {
-            emit reloadProject();
-        } else if (choice == QMessageBox::No) {
-            if (showAgainCheck.isChecked()) {
-                porymapConfig.setMonitorFiles(false);
-                emit uncheckMonitorFilesAction();
-            }
+                                  .arg(changed.first()));
+    } else {
+        notice.setInformativeText(QString("%1 files have changed on disk. Would you like to reload the project?")
+                                  .arg(changed.length()));
+        notice.setDetailedText(changed.join("\n"));
+    }
+    notice.setStandardButtons(QMessageBox::No | QMessageBox::Yes);
+    notice.setDefaultButton(QMessageBox::No);
+    notice.setIcon(QMessageBox::Question);
+
+    QCheckBox showAgainCheck("Do not ask again.");
+    notice.setCheckBox(&showAgainCheck);
+
+    showing = true;
+    int choice = notice.exec();
+    if (choice == QMessageBox::Yes) {
+        emit reloadProject();
+    } else if (choice == QMessageBox::No) {
+        if (showAgainCheck.isChecked()) {
+            porymapConfig.setMonitorFiles(false);
+            emit uncheckMonitorFilesAction();
         }
-        showing = false;
-    });
+    }
+    showing = false;
 }
 
 void Project::set_root(QString dir) {
@@ -99,6 +194,22 @@ QString Project::getProjectTitle() {
     }
 }
 
+// Returns a model listing the given names (and optionally their values), shared by every combo box
+// that lists them, so large lists like flags or vars aren't copied into each one.
+// If the list has changed since the model was created a new model is made,
+// because resetting the old one would change the selection of the combo boxes using it.
+// The old model is deleted once the combo boxes using it have switched to the new one, or have been deleted.
+ConstantListModel *Project::getListModel(const QString &name, const QStringList &list, const QVariantList &values) {
+    ConstantListModel *model = this->listModels.value(name);
+    if (!model || model->names() != list || model->values() != values) {
+        if (model)
+            model->setSuperseded();
+        model = new ConstantListModel(list, values, this);
+        this->listModels.insert(name, model);
+    }
+    return model;
+}
+
 void Project::clearMapCache() {
     for (auto *map : mapCache.values()) {
         if (map)
@@ -117,6 +228,8 @@ void Project::clearTilesetCache() {
 }
 
 Map* Project::loadMap(QString map_name) {
+    PROFILE_SCOPE("Project::loadMap");
+    Profiling::addCacheResult("Project::loadMap", mapCache.contains(map_name));
     Map *map;
     if (mapCache.contains(map_name)) {
         map = mapCache.value(map_name);
@@ -175,10 +288,15 @@ QSet<QString> Project::getTopLevelMapFields() {
 }
 
 bool Project::loadMapData(Map* map) {
+    PROFILE_SCOPE("Project::loadMapData");
     if (!map->isPersistedToFile) {
         return true;
     }
 
+    // The map's script labels are usually already known from the script label index.
+    map->scriptsFileLabels = getGlobalScriptLabels(map->getScriptsFilePath());
+    map->scriptsLoaded = true;
+
     QString mapFilepath = QString("%1/%3%2/map.json").arg(root).arg(map->name).arg(projectConfig.getFilePath(ProjectFilePath::data_map_folders));
     QJsonDocument mapDoc;
     if (!parser.tryParseJsonFile(&mapDoc, mapFilepath)) {
@@ -289,24 +407,22 @@ bool Project::loadMapData(Map* map) {
     map->events[Event::Group::Heal].clear();
     
     const QString mapPrefix = projectConfig.getIdentifier(ProjectIdentifier::define_map_prefix);
-    for (auto it = healLocations.begin(); it != healLocations.end(); it++) {
-        HealLocation loc = *it;
-        //if TRUE map is flyable / has healing location
-        if (loc.mapName == Map::mapConstantFromName(map->name, false)) {
-            HealLocationEvent *heal = new HealLocationEvent();
-            heal->setMap(map);
-            heal->setX(loc.x);
-            heal->setY(loc.y);
-            heal->setElevation(projectConfig.getDefaultElevation());
-            heal->setLocationName(loc.mapName);
-            heal->setIdName(loc.idName);
-            heal->setIndex(loc.index);
-            if (projectConfig.getHealLocationRespawnDataEnabled()) {
-                heal->setRespawnMap(mapConstantsToMapNames.value(QString(mapPrefix + loc.respawnMap)));
-                heal->setRespawnNPC(loc.respawnNPC);
-            }
-            map->events[Event::Group::Heal].append(heal);
-        }
+    // Heal locations are indexed by map, see indexHealLocation
+    for (int i : healLocationsByMap.value(Map::mapConstantFromName(map->name, false))) {
+        const HealLocation &loc = healLocations.at(i);
+        HealLocationEvent *heal = new HealLocationEvent();
+        heal->setMap(map);
+        heal->setX(loc.x);
+        heal->setY(loc.y);
+        heal->setElevation(projectConfig.getDefaultElevation());
+        heal->setLocationName(loc.mapName);
+        heal->setIdName(loc.idName);
+        heal->setIndex(loc.index);
+        if (projectConfig.getHealLocationRespawnDataEnabled()) {
+            heal->setRespawnMap(mapConstantsToMapNames.value(QString(mapPrefix + loc.respawnMap)));
+            heal->setRespawnNPC(loc.respawnNPC);
+        }
+        map->events[Event::Group::Heal].append(heal);
     }
 
     map->connections.clear();
@@ -343,15 +459,11 @@ QString Project::readMapLayoutId(QString map_name) {
         return mapCache.value(map_name)->layoutId;
     }
 
-    QString mapFilepath = QString("%1/%3%2/map.json").arg(root).arg(map_name).arg(projectConfig.getFilePath(ProjectFilePath::data_map_folders));
-    QJsonDocument mapDoc;
-    if (!parser.tryParseJsonFile(&mapDoc, mapFilepath)) {
-        logError(QString("Failed to read map layout id from %1").arg(mapFilepath));
+    if (!mapHeaders.contains(map_name)) {
+        logError(QString("Failed to read map layout id for '%1'").arg(map_name));
         return QString();
     }
-
-    QJsonObject mapObj = mapDoc.object();
-    return ParseUtil::jsonToQString(mapObj["layout"]);
+    return mapHeaders.value(map_name).layoutId;
 }
 
 QString Project::readMapLocation(QString map_name) {
@@ -359,18 +471,81 @@ QString Project::readMapLocation(QString map_name) {
         return mapCache.value(map_name)->location;
     }
 
-    QString mapFilepath = QString("%1/%3%2/map.json").arg(root).arg(map_name).arg(projectConfig.getFilePath(ProjectFilePath::data_map_folders));
-    QJsonDocument mapDoc;
-    if (!parser.tryParseJsonFile(&mapDoc, mapFilepath)) {
-        logError(QString("Failed to read map's region map section from %1").arg(mapFilepath));
+    if (!mapHeaders.contains(map_name)) {
+        logError(QString("Failed to read map's region map section for '%1'").arg(map_name));
         return QString();
     }
+    return mapHeaders.value(map_name).location;
+}
 
-    QJsonObject mapObj = mapDoc.object();
-    return ParseUtil::jsonToQString(mapObj["region_map_section"]);
+static MapHeader mapHeaderFromMap(Map *map) {
+    MapHeader header;
+    header.layoutId = map->layoutId;
+    header.location = map->location;
+    header.type = map->type;
+    header.song = map->song;
+    for (MapConnection *connection : map->connections)
+        header.connectedMaps.append(connection->map_name);
+    return header;
+}
+
+// Reads the header fields of every map. Only the few fields needed are extracted from each map.json
+// rather than parsing the whole file, and the files are read concurrently.
+bool Project::readMapHeaders() {
+    PROFILE_SCOPE("Project::readMapHeaders");
+    this->mapHeaders.clear();
+
+    struct MapHeaderData {
+        QString mapName;
+        MapHeader header;
+        QString error;
+    };
+    QVector<MapHeaderData> headerData;
+    for (const QString &mapName : this->mapNames) {
+        if (mapName == DYNAMIC_MAP_NAME)
+            continue;
+        MapHeaderData data;
+        data.mapName = mapName;
+        headerData.append(data);
+    }
+
+    const QString mapsDir = QString("%1/%2").arg(root).arg(projectConfig.getFilePath(ProjectFilePath::data_map_folders));
+    const QStringList keys = {"layout", "region_map_section", "map_type", "music", "connections"};
+    QtConcurrent::blockingMap(headerData, [this, &mapsDir, &keys](MapHeaderData &data) {
+        const QString mapFilepath = QString("%1%2/map.json").arg(mapsDir).arg(data.mapName);
+        QFile file(mapFilepath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            data.error = QString("Error: Could not open %1 for reading").arg(mapFilepath);
+            return;
+        }
+        QJsonObject fields;
+        if (!ParseUtil::readJsonFields(file.readAll(), keys, &fields)) {
+            data.error = QString("Error: Failed to parse json file %1").arg(mapFilepath);
+            return;
+        }
+        data.header.layoutId = ParseUtil::jsonToQString(fields["layout"]);
+        data.header.location = ParseUtil::jsonToQString(fields["region_map_section"]);
+        data.header.type = ParseUtil::jsonToQString(fields["map_type"]);
+        data.header.song = ParseUtil::jsonToQString(fields["music"]);
+        for (const QJsonValue &connection : fields["connections"].toArray()) {
+            const QString mapConstant = ParseUtil::jsonToQString(connection.toObject()["map"]);
+            data.header.connectedMaps.append(this->mapConstantsToMapNames.value(mapConstant, mapConstant));
+        }
+    });
+
+    for (const MapHeaderData &data : headerData) {
+        if (!data.error.isEmpty()) {
+            // Maps that fail to read here will report their errors again if they're opened, so this isn't fatal.
+            logError(data.error);
+            continue;
+        }
+        this->mapHeaders.insert(data.mapName, data.header);
+    }
+    return true;
 }
 
 bool Project::loadLayout(MapLayout *layout) {
+    PROFILE_SCOPE("Project::loadLayout");
     // Force these to run even if one fails
     bool loadedTilesets = loadLayoutTilesets(layout);
     bool loadedBlockdata = loadBlockdata(layout);
@@ -382,6 +557,7 @@ bool Project::loadLayout(MapLayout *layout) {
 }
 
 bool Project::loadMapLayout(Map* map) {
+    PROFILE_SCOPE("Project::loadMapLayout");
     if (!map->isPersistedToFile) {
         return true;
     }
@@ -401,12 +577,13 @@ bool Project::loadMapLayout(Map* map) {
 }
 
 bool Project::readMapLayouts() {
+    PROFILE_SCOPE("Project::readMapLayouts");
     mapLayouts.clear();
     mapLayoutsTable.clear();
 
     QString layoutsFilepath = projectConfig.getFilePath(ProjectFilePath::json_layouts);
     QString fullFilepath = QString("%1/%2").arg(root).arg(layoutsFilepath);
-    fileWatcher.addPath(fullFilepath);
+    watchFile(fullFilepath);
     QJsonDocument layoutsDoc;
     if (!parser.tryParseJsonFile(&layoutsDoc, fullFilepath)) {
         logError(QString("Failed to read map layouts from %1").arg(fullFilepath));
@@ -535,12 +712,8 @@ bool Project::readMapLayouts() {
 }
 
 void Project::saveMapLayouts() {
+    PROFILE_SCOPE("Project::saveMapLayouts");
     QString layoutsFilepath = root + "/" + projectConfig.getFilePath(ProjectFilePath::json_layouts);
-    QFile layoutsFile(layoutsFilepath);
-    if (!layoutsFile.open(QIODevice::WriteOnly)) {
-        logError(QString("Error: Could not open %1 for writing").arg(layoutsFilepath));
-        return;
-    }
 
     OrderedJson::object layoutsObj;
     layoutsObj["layouts_table_label"] = layoutsLabel;
@@ -570,8 +743,14 @@ void Project::saveMapLayouts() {
     layoutsObj["layouts"] = layoutsArr;
     OrderedJson layoutJson(layoutsObj);
     OrderedJsonDoc jsonDoc(&layoutJson);
-    jsonDoc.dump(&layoutsFile);
-    layoutsFile.close();
+    writeJsonFile(layoutsFilepath, jsonDoc.toUtf8());
+}
+
+void Project::writeJsonFile(const QString &filepath, const QByteArray &data) {
+    QString error;
+    if (!FileUtil::writeIfChanged(filepath, data, &error)) {
+        logError(QString("Error: Could not open %1 for writing: %2").arg(filepath).arg(error));
+    }
 }
 
 void Project::ignoreWatchedFileTemporarily(QString filepath) {
@@ -580,12 +759,8 @@ void Project::ignoreWatchedFileTemporarily(QString filepath) {
 }
 
 void Project::saveMapGroups() {
+    PROFILE_SCOPE("Project::saveMapGroups");
     QString mapGroupsFilepath = QString("%1/%2").arg(root).arg(projectConfig.getFilePath(ProjectFilePath::json_map_groups));
-    QFile mapGroupsFile(mapGroupsFilepath);
-    if (!mapGroupsFile.open(QIODevice::WriteOnly)) {
-        logError(QString("Error: Could not open %1 for writing").arg(mapGroupsFilepath));
-        return;
-    }
 
     OrderedJson::object mapGroupsObj;
 
@@ -609,19 +784,14 @@ void Project::saveMapGroups() {
 
     OrderedJson mapGroupJson(mapGroupsObj);
     OrderedJsonDoc jsonDoc(&mapGroupJson);
-    jsonDoc.dump(&mapGroupsFile);
-    mapGroupsFile.close();
+    writeJsonFile(mapGroupsFilepath, jsonDoc.toUtf8());
 }
 
 void Project::saveWildMonData() {
+    PROFILE_SCOPE("Project::saveWildMonData");
     if (!this->wildEncountersLoaded) return;
 
     QString wildEncountersJsonFilepath = QString("%1/%2").arg(root).arg(projectConfig.getFilePath(ProjectFilePath::json_wild_encounters));
-    QFile wildEncountersFile(wildEncountersJsonFilepath);
-    if (!wildEncountersFile.open(QIODevice::WriteOnly)) {
-        logError(QString("Error: Could not open %1 for writing").arg(wildEncountersJsonFilepath));
-        return;
-    }
 
     OrderedJson::object wildEncountersObject;
     OrderedJson::array wildEncounterGroups;
@@ -700,11 +870,11 @@ void Project::saveWildMonData() {
     ignoreWatchedFileTemporarily(wildEncountersJsonFilepath);
     OrderedJson encounterJson(wildEncountersObject);
     OrderedJsonDoc jsonDoc(&encounterJson);
-    jsonDoc.dump(&wildEncountersFile);
-    wildEncountersFile.close();
+    writeJsonFile(wildEncountersJsonFilepath, jsonDoc.toUtf8());
 }
 
 void Project::saveMapConstantsHeader() {
+    PROFILE_SCOPE("Project::saveMapConstantsHeader");
     QString text = QString("#ifndef GUARD_CONSTANTS_MAP_GROUPS_H\n");
     text += QString("#define GUARD_CONSTANTS_MAP_GROUPS_H\n");
     text += QString("\n//\n// DO NOT MODIFY THIS FILE! It is auto-generated from %1\n//\n\n")
@@ -742,20 +912,44 @@ void Project::saveMapConstantsHeader() {
 }
 
 void Project::saveHealLocations(Map *map) {
-    this->saveHealLocationsData(map);
+    PROFILE_SCOPE("Project::saveHealLocations");
+    this->updateHealLocations(map);
+    this->saveHealLocationsData();
     this->saveHealLocationsConstants();
 }
 
-// Saves heal location maps/coords/respawn data in root + /src/data/heal_locations.h
-void Project::saveHealLocationsData(Map *map) {
-    // Update heal locations from map
-    if (map->events[Event::Group::Heal].length() > 0) {
-        for (Event *healEvent : map->events[Event::Group::Heal]) {
-            HealLocation hl = HealLocation::fromEvent(healEvent);
-            this->healLocations[hl.index - 1] = hl;
+// Update heal locations from map
+void Project::updateHealLocations(Map *map) {
+    for (Event *healEvent : map->events[Event::Group::Heal]) {
+        HealLocation hl = HealLocation::fromEvent(healEvent);
+        const int i = hl.index - 1;
+        const QString oldMapName = this->healLocations.at(i).mapName;
+        this->healLocations[i] = hl;
+        if (oldMapName != hl.mapName) {
+            this->healLocationsByMap[oldMapName].removeOne(i);
+            this->indexHealLocation(i);
         }
     }
+}
 
+// Adds a new heal location and returns its index (as used by its constant, starting at 1).
+int Project::addHealLocation(HealLocation healLocation) {
+    healLocation.index = this->healLocations.length() + 1;
+    this->healLocations.append(healLocation);
+    this->indexHealLocation(healLocation.index - 1);
+    return healLocation.index;
+}
+
+// Heal locations are looked up by map constant whenever a map is loaded, so their positions
+// in the list are kept in order for each map.
+void Project::indexHealLocation(int i) {
+    QList<int> &indexes = this->healLocationsByMap[this->healLocations.at(i).mapName];
+    indexes.insert(std::lower_bound(indexes.begin(), indexes.end(), i), i);
+}
+
+// Saves heal location maps/coords/respawn data in root + /src/data/heal_locations.h
+void Project::saveHealLocationsData() {
+    PROFILE_SCOPE("Project::saveHealLocationsData");
     // Find any duplicate constant names
     QMap<QString, int> healLocationsDupes;
     QSet<QString> healLocationsUnique;
@@ -826,6 +1020,7 @@ void Project::saveHealLocationsData(Map *map) {
 
 // Saves heal location defines in root + /include/constants/heal_locations.h
 void Project::saveHealLocationsConstants() {
+    PROFILE_SCOPE("Project::saveHealLocationsConstants");
     // Get existing defines, and create an inverted map so they'll be in sorted order for printing
     int nextDefineValue = 1;
     QMap<int, QString> valuesToNames = QMap<int, QString>();
@@ -869,15 +1064,67 @@ void Project::saveHealLocationsConstants() {
 }
 
 void Project::saveTilesets(Tileset *primaryTileset, Tileset *secondaryTileset) {
+    PROFILE_SCOPE("Project::saveTilesets");
     saveTilesetMetatileLabels(primaryTileset, secondaryTileset);
-    saveTilesetMetatileAttributes(primaryTileset);
-    saveTilesetMetatileAttributes(secondaryTileset);
-    saveTilesetMetatiles(primaryTileset);
-    saveTilesetMetatiles(secondaryTileset);
-    saveTilesetTilesImage(primaryTileset);
-    saveTilesetTilesImage(secondaryTileset);
-    saveTilesetPalettes(primaryTileset);
-    saveTilesetPalettes(secondaryTileset);
+
+    // Each file is built as a separate job, so that encoding a large tiles image doesn't hold up the other files.
+    enum class TilesetFile {
+        MetatileAttributes,
+        Metatiles,
+        TilesImage,
+        Palette,
+    };
+    struct TilesetFileData {
+        Tileset *tileset = nullptr;
+        TilesetFile type;
+        int paletteId = 0;
+        QByteArray data;
+    };
+    QVector<TilesetFileData> fileData;
+    for (Tileset *tileset : {primaryTileset, secondaryTileset}) {
+        fileData.append({tileset, TilesetFile::MetatileAttributes});
+        fileData.append({tileset, TilesetFile::Metatiles});
+        if (tileset->hasUnsavedTilesImage)
+            fileData.append({tileset, TilesetFile::TilesImage});
+        for (int i = 0; i < Project::getNumPalettesTotal(); i++)
+            fileData.append({tileset, TilesetFile::Palette, i});
+    }
+
+    const int attributesSize = projectConfig.getMetatileAttributesSize();
+    const int numTilesInMetatile = projectConfig.getNumTilesInMetatile();
+    QtConcurrent::blockingMap(fileData, [attributesSize, numTilesInMetatile](TilesetFileData &file) {
+        switch (file.type) {
+        case TilesetFile::MetatileAttributes:
+            file.data = Metatile::serializeAttributes(file.tileset->metatiles, attributesSize);
+            break;
+        case TilesetFile::Metatiles:
+            file.data = Metatile::serializeTiles(file.tileset->metatiles, numTilesInMetatile);
+            break;
+        case TilesetFile::TilesImage:
+            file.data = encodeTilesImage(file.tileset->tilesImage);
+            break;
+        case TilesetFile::Palette:
+            file.data = PaletteUtil::serializeJASC(file.tileset->palettes.at(file.paletteId).toVector(), 0, 16);
+            break;
+        }
+    });
+
+    for (const TilesetFileData &file : fileData) {
+        switch (file.type) {
+        case TilesetFile::MetatileAttributes:
+            writeTilesetMetatileAttributes(file.tileset, file.data);
+            break;
+        case TilesetFile::Metatiles:
+            writeTilesetMetatiles(file.tileset, file.data);
+            break;
+        case TilesetFile::TilesImage:
+            writeTilesetTilesImage(file.tileset, file.data);
+            break;
+        case TilesetFile::Palette:
+            writeTilesetPalette(file.tileset, file.paletteId, file.data);
+            break;
+        }
+    }
 }
 
 void Project::updateTilesetMetatileLabels(Tileset *tileset) {
@@ -915,6 +1162,7 @@ QString Project::buildMetatileLabelsText(const QMap<QString, uint16_t> defines)
 }
 
 void Project::saveTilesetMetatileLabels(Tileset *primaryTileset, Tileset *secondaryTileset) {
+    PROFILE_SCOPE("Project::saveTilesetMetatileLabels");
     // Skip writing the file if there are no labels in both the new and old sets
     if (metatileLabelsMap[primaryTileset->name].size() == 0 && primaryTileset->metatileLabels.size() == 0
      && metatileLabelsMap[secondaryTileset->name].size() == 0 && secondaryTileset->metatileLabels.size() == 0)
@@ -948,60 +1196,77 @@ void Project::saveTilesetMetatileLabels(Tileset *primaryTileset, Tileset *second
 }
 
 void Project::saveTilesetMetatileAttributes(Tileset *tileset) {
-    QFile attrs_file(tileset->metatile_attrs_path);
-    if (attrs_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QByteArray data;
-        int attrSize = projectConfig.getMetatileAttributesSize();
-        for (Metatile *metatile : tileset->metatiles) {
-            uint32_t attributes = metatile->getAttributes();
-            for (int i = 0; i < attrSize; i++)
-                data.append(static_cast<char>(attributes >> (8 * i)));
-        }
-        attrs_file.write(data);
-    } else {
+    PROFILE_SCOPE("Project::saveTilesetMetatileAttributes");
+    writeTilesetMetatileAttributes(tileset, Metatile::serializeAttributes(tileset->metatiles, projectConfig.getMetatileAttributesSize()));
+}
+
+void Project::writeTilesetMetatileAttributes(Tileset *tileset, const QByteArray &data) {
+    if (!FileUtil::writeIfChanged(tileset->metatile_attrs_path, data)) {
         logError(QString("Could not save tileset metatile attributes file '%1'").arg(tileset->metatile_attrs_path));
     }
 }
 
 void Project::saveTilesetMetatiles(Tileset *tileset) {
-    QFile metatiles_file(tileset->metatiles_path);
-    if (metatiles_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QByteArray data;
-        int numTiles = projectConfig.getNumTilesInMetatile();
-        for (Metatile *metatile : tileset->metatiles) {
-            for (int i = 0; i < numTiles; i++) {
-                uint16_t tile = metatile->tiles.at(i).rawValue();
-                data.append(static_cast<char>(tile));
-                data.append(static_cast<char>(tile >> 8));
-            }
-        }
-        metatiles_file.write(data);
-    } else {
+    PROFILE_SCOPE("Project::saveTilesetMetatiles");
+    writeTilesetMetatiles(tileset, Metatile::serializeTiles(tileset->metatiles, projectConfig.getNumTilesInMetatile()));
+}
+
+void Project::writeTilesetMetatiles(Tileset *tileset, const QByteArray &data) {
+    if (!FileUtil::writeIfChanged(tileset->metatiles_path, data)) {
         tileset->metatiles.clear();
         logError(QString("Could not open tileset metatiles file '%1'").arg(tileset->metatiles_path));
     }
 }
 
 void Project::saveTilesetTilesImage(Tileset *tileset) {
+    PROFILE_SCOPE("Project::saveTilesetTilesImage");
     // Only write the tiles image if it was changed.
     // Porymap will only ever change an existing tiles image by importing a new one.
     if (tileset->hasUnsavedTilesImage) {
-        if (!tileset->tilesImage.save(tileset->tilesImagePath, "PNG")) {
-            logError(QString("Failed to save tiles image '%1'").arg(tileset->tilesImagePath));
-            return;
-        }
+        writeTilesetTilesImage(tileset, encodeTilesImage(tileset->tilesImage));
+    }
+}
+
+// Returns the tiles image encoded as a PNG, or an empty array if it couldn't be encoded.
+QByteArray Project::encodeTilesImage(const QImage &image) {
+    QByteArray data;
+    QBuffer buffer(&data);
+    if (!buffer.open(QIODevice::WriteOnly) || !image.save(&buffer, "PNG"))
+        return QByteArray();
+    return data;
+}
+
+void Project::writeTilesetTilesImage(Tileset *tileset, const QByteArray &data) {
+    QString error;
+    if (data.isEmpty()) {
+        error = "The image could not be encoded";
+    } else if (FileUtil::writeIfChanged(tileset->tilesImagePath, data, &error)) {
         tileset->hasUnsavedTilesImage = false;
+        return;
     }
+    logError(QString("Failed to save tiles image '%1': ").arg(tileset->tilesImagePath) + error);
 }
 
 void Project::saveTilesetPalettes(Tileset *tileset) {
+    PROFILE_SCOPE("Project::saveTilesetPalettes");
     for (int i = 0; i < Project::getNumPalettesTotal(); i++) {
         QString filepath = tileset->palettePaths.at(i);
         PaletteUtil::writeJASC(filepath, tileset->palettes.at(i).toVector(), 0, 16);
     }
 }
 
+void Project::writeTilesetPalette(Tileset *tileset, int paletteId, const QByteArray &data) {
+    if (data.isEmpty())
+        return;
+    const QString filepath = tileset->palettePaths.at(paletteId);
+    QString error;
+    if (!FileUtil::writeIfChanged(filepath, data, &error)) {
+        logWarn(QString("Could not write to file '%1': ").arg(filepath) + error);
+    }
+}
+
 bool Project::loadLayoutTilesets(MapLayout *layout) {
+    PROFILE_SCOPE("Project::loadLayoutTilesets");
     layout->tileset_primary = getTileset(layout->tileset_primary_label);
     if (!layout->tileset_primary) {
         QString defaultTileset = this->getDefaultPrimaryTilesetLabel();
@@ -1029,6 +1294,7 @@ bool Project::loadLayoutTilesets(MapLayout *layout) {
 }
 
 Tileset* Project::loadTileset(QString label, Tileset *tileset) {
+    PROFILE_SCOPE("Project::loadTileset");
     auto memberMap = Tileset::getHeaderMemberMap(this->usingAsmTilesets);
     if (this->usingAsmTilesets) {
         // Read asm tileset header. Backwards compatibility
@@ -1070,6 +1336,7 @@ Tileset* Project::loadTileset(QString label, Tileset *tileset) {
 }
 
 bool Project::loadBlockdata(MapLayout *layout) {
+    PROFILE_SCOPE("Project::loadBlockdata");
     QString path = QString("%1/%2").arg(root).arg(layout->blockdata_path);
     layout->blockdata = readBlockdata(path);
     layout->lastCommitBlocks.blocks = layout->blockdata;
@@ -1099,6 +1366,7 @@ void Project::setNewMapBlockdata(Map *map) {
 }
 
 bool Project::loadLayoutBorder(MapLayout *layout) {
+    PROFILE_SCOPE("Project::loadLayoutBorder");
     QString path = QString("%1/%2").arg(root).arg(layout->border_path);
     layout->border = readBlockdata(path);
     layout->lastCommitBlocks.border = layout->border;
@@ -1138,72 +1406,77 @@ void Project::setNewMapBorder(Map *map) {
 }
 
 void Project::saveLayoutBorder(Map *map) {
+    PROFILE_SCOPE("Project::saveLayoutBorder");
     QString path = QString("%1/%2").arg(root).arg(map->layout->border_path);
     writeBlockdata(path, map->layout->border);
 }
 
 void Project::saveLayoutBlockdata(Map* map) {
+    PROFILE_SCOPE("Project::saveLayoutBlockdata");
     QString path = QString("%1/%2").arg(root).arg(map->layout->blockdata_path);
     writeBlockdata(path, map->layout->blockdata);
 }
 
 void Project::writeBlockdata(QString path, const Blockdata &blockdata) {
-    QFile file(path);
-    if (file.open(QIODevice::WriteOnly)) {
-        QByteArray data = blockdata.serialize();
-        file.write(data);
-    } else {
+    writeBlockdata(path, blockdata.serialize());
+}
+
+void Project::writeBlockdata(QString path, const QByteArray &data) {
+    if (!FileUtil::writeIfChanged(path, data)) {
         logError(QString("Failed to open blockdata file for writing: '%1'").arg(path));
     }
 }
 
+// Only maps with changes are written. Any files whose contents would be unchanged are skipped when writing.
 void Project::saveAllMaps() {
-    for (auto *map : mapCache.values())
-        saveMap(map);
+    PROFILE_SCOPE("Project::saveAllMaps");
+    QList<Map*> maps;
+    for (auto *map : mapCache.values()) {
+        if (map->hasUnsavedChanges())
+            maps.append(map);
+    }
+    saveMaps(maps);
 }
 
 void Project::saveMap(Map *map) {
-    // Create/Modify a few collateral files for brand new maps.
-    QString basePath = projectConfig.getFilePath(ProjectFilePath::data_map_folders);
-    QString mapDataDir = root + "/" + basePath + map->name;
-    if (!map->isPersistedToFile) {
-        if (!QDir::root().mkdir(mapDataDir)) {
-            logError(QString("Error: failed to create directory for new map: '%1'").arg(mapDataDir));
-        }
-
-        // Create file data/maps/<map_name>/scripts.inc
-        QString text = this->getScriptDefaultString(projectConfig.getUsePoryScript(), map->name);
-        saveTextFile(mapDataDir + "/scripts" + this->getScriptFileExtension(projectConfig.getUsePoryScript()), text);
+    saveMaps(QList<Map*>({map}));
+}
 
-        bool usesTextFile = projectConfig.getCreateMapTextFileEnabled();
-        if (usesTextFile) {
-            // Create file data/maps/<map_name>/text.inc
-            saveTextFile(mapDataDir + "/text" + this->getScriptFileExtension(projectConfig.getUsePoryScript()), "\n");
-        }
+// Building the contents of each map's files only reads data, so it's done for all the maps
+// concurrently. The files are then written (and the project data updated) on this thread.
+void Project::saveMaps(const QList<Map*> &maps) {
+    PROFILE_SCOPE("Project::saveMaps");
+    if (maps.isEmpty())
+        return;
 
-        // Simply append to data/event_scripts.s.
-        text = QString("\n\t.include \"%1%2/scripts.inc\"\n").arg(basePath, map->name);
-        if (usesTextFile) {
-            text += QString("\t.include \"%1%2/text.inc\"\n").arg(basePath, map->name);
-        }
-        appendTextFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_event_scripts), text);
+    struct MapFileData {
+        Map *map = nullptr;
+        QByteArray mapJson;
+        QByteArray border;
+        QByteArray blockdata;
+        QStringList errors;
+    };
+    QVector<MapFileData> fileData(maps.length());
+    for (int i = 0; i < maps.length(); i++)
+        fileData[i].map = maps.at(i);
+
+    QtConcurrent::blockingMap(fileData, [this](MapFileData &data) {
+        data.mapJson = this->buildMapJson(data.map, &data.errors);
+        data.border = data.map->layout->border.serialize();
+        data.blockdata = data.map->layout->blockdata.serialize();
+    });
 
-        if (map->needsLayoutDir) {
-            QString newLayoutDir = QString(root + "/%1%2").arg(projectConfig.getFilePath(ProjectFilePath::data_layouts_folders), map->name);
-            if (!QDir::root().mkdir(newLayoutDir)) {
-                logError(QString("Error: failed to create directory for new layout: '%1'").arg(newLayoutDir));
-            }
-        }
+    for (const MapFileData &data : fileData) {
+        for (const QString &error : data.errors)
+            logError(error);
+        this->writeMapFiles(data.map, data.mapJson, data.border, data.blockdata);
     }
 
-    // Create map.json for map data.
-    QString mapFilepath = QString("%1/map.json").arg(mapDataDir);
-    QFile mapFile(mapFilepath);
-    if (!mapFile.open(QIODevice::WriteOnly)) {
-        logError(QString("Error: Could not open %1 for writing").arg(mapFilepath));
-        return;
-    }
+    saveHealLocationsData();
+    saveHealLocationsConstants();
+}
 
+QByteArray Project::buildMapJson(Map *map, QStringList *errors) {
     OrderedJson::object mapObj;
     // Header values.
     mapObj["id"] = map->constantName;
@@ -1236,7 +1509,7 @@ void Project::saveMap(Map *map) {
                 connectionObj["direction"] = connection->direction;
                 connectionsArr.append(connectionObj);
             } else {
-                logError(QString("Failed to write map connection. '%1' is not a valid map name").arg(connection->map_name));
+                errors->append(QString("Failed to write map connection. '%1' is not a valid map name").arg(connection->map_name));
             }
         }
         mapObj["connections"] = connectionsArr;
@@ -1296,15 +1569,58 @@ void Project::saveMap(Map *map) {
 
     OrderedJson mapJson(mapObj);
     OrderedJsonDoc jsonDoc(&mapJson);
-    jsonDoc.dump(&mapFile);
-    mapFile.close();
+    return jsonDoc.toUtf8();
+}
+
+void Project::writeMapFiles(Map *map, const QByteArray &mapJson, const QByteArray &border, const QByteArray &blockdata) {
+    // Create/Modify a few collateral files for brand new maps.
+    QString basePath = projectConfig.getFilePath(ProjectFilePath::data_map_folders);
+    QString mapDataDir = root + "/" + basePath + map->name;
+    if (!map->isPersistedToFile) {
+        if (!QDir::root().mkdir(mapDataDir)) {
+            logError(QString("Error: failed to create directory for new map: '%1'").arg(mapDataDir));
+        }
+
+        // Create file data/maps/<map_name>/scripts.inc
+        QString text = this->getScriptDefaultString(projectConfig.getUsePoryScript(), map->name);
+        saveTextFile(mapDataDir + "/scripts" + this->getScriptFileExtension(projectConfig.getUsePoryScript()), text);
+
+        bool usesTextFile = projectConfig.getCreateMapTextFileEnabled();
+        if (usesTextFile) {
+            // Create file data/maps/<map_name>/text.inc
+            saveTextFile(mapDataDir + "/text" + this->getScriptFileExtension(projectConfig.getUsePoryScript()), "\n");
+        }
+
+        // Simply append to data/event_scripts.s.
+        text = QString("\n\t.include \"%1%2/scripts.inc\"\n").arg(basePath, map->name);
+        if (usesTextFile) {
+            text += QString("\t.include \"%1%2/text.inc\"\n").arg(basePath, map->name);
+        }
+        appendTextFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_event_scripts), text);
+
+        if (map->needsLayoutDir) {
+            QString newLayoutDir = QString(root + "/%1%2").arg(projectConfig.getFilePath(ProjectFilePath::data_layouts_folders), map->name);
+            if (!QDir::root().mkdir(newLayoutDir)) {
+                logError(QString("Error: failed to create directory for new layout: '%1'").arg(newLayoutDir));
+            }
+        }
+    }
 
-    saveLayoutBorder(map);
-    saveLayoutBlockdata(map);
-    saveHealLocations(map);
+    // Create map.json for map data.
+    QString mapFilepath = QString("%1/map.json").arg(mapDataDir);
+    QString error;
+    if (!FileUtil::writeIfChanged(mapFilepath, mapJson, &error)) {
+        logError(QString("Error: Could not open %1 for writing: %2").arg(mapFilepath).arg(error));
+        return;
+    }
+
+    writeBlockdata(QString("%1/%2").arg(root).arg(map->layout->border_path), border);
+    writeBlockdata(QString("%1/%2").arg(root).arg(map->layout->blockdata_path), blockdata);
+    updateHealLocations(map);
 
     // Update global data structures with current map data.
     updateMapLayout(map);
+    mapHeaders.insert(map->name, mapHeaderFromMap(map));
 
     map->isPersistedToFile = true;
     map->hasUnsavedDataChanges = false;
@@ -1324,6 +1640,7 @@ void Project::updateMapLayout(Map* map) {
 }
 
 void Project::saveAllDataStructures() {
+    PROFILE_SCOPE("Project::saveAllDataStructures");
     saveMapLayouts();
     saveMapGroups();
     saveMapConstantsHeader();
@@ -1331,6 +1648,7 @@ void Project::saveAllDataStructures() {
 }
 
 void Project::loadTilesetAssets(Tileset* tileset) {
+    PROFILE_SCOPE("Project::loadTilesetAssets");
     if (tileset->name.isNull()) {
         return;
     }
@@ -1349,6 +1667,7 @@ void Project::loadTilesetAssets(Tileset* tileset) {
 }
 
 void Project::readTilesetPaths(Tileset* tileset) {
+    PROFILE_SCOPE("Project::readTilesetPaths");
     // Parse the tileset data files to try and get explicit file paths for this tileset's assets
     const QString rootDir = this->root + "/";
     if (this->usingAsmTilesets) {
@@ -1406,6 +1725,7 @@ void Project::readTilesetPaths(Tileset* tileset) {
 }
 
 void Project::loadTilesetPalettes(Tileset* tileset) {
+    PROFILE_SCOPE("Project::loadTilesetPalettes");
     QList<QList<QRgb>> palettes;
     QList<QList<QRgb>> palettePreviews;
     for (int i = 0; i < tileset->palettePaths.length(); i++) {
@@ -1426,6 +1746,7 @@ void Project::loadTilesetPalettes(Tileset* tileset) {
 }
 
 void Project::loadTilesetTiles(Tileset *tileset, QImage image) {
+    PROFILE_SCOPE("Project::loadTilesetTiles");
     QList<QImage> tiles;
     int w = 8;
     int h = 8;
@@ -1439,24 +1760,10 @@ void Project::loadTilesetTiles(Tileset *tileset, QImage image) {
 }
 
 void Project::loadTilesetMetatiles(Tileset* tileset) {
+    PROFILE_SCOPE("Project::loadTilesetMetatiles");
     QFile metatiles_file(tileset->metatiles_path);
     if (metatiles_file.open(QIODevice::ReadOnly)) {
-        QByteArray data = metatiles_file.readAll();
-        int tilesPerMetatile = projectConfig.getNumTilesInMetatile();
-        int bytesPerMetatile = 2 * tilesPerMetatile;
-        int num_metatiles = data.length() / bytesPerMetatile;
-        QList<Metatile*> metatiles;
-        for (int i = 0; i < num_metatiles; i++) {
-            Metatile *metatile = new Metatile;
-            int index = i * bytesPerMetatile;
-            for (int j = 0; j < tilesPerMetatile; j++) {
-                uint16_t tileRaw = static_cast<unsigned char>(data[index++]);
-                tileRaw |= static_cast<unsigned char>(data[index++]) << 8;
-                metatile->tiles.append(Tile(tileRaw));
-            }
-            metatiles.append(metatile);
-        }
-        tileset->metatiles = metatiles;
+        tileset->metatiles = Metatile::deserializeTiles(metatiles_file.readAll(), projectConfig.getNumTilesInMetatile());
     } else {
         tileset->metatiles.clear();
         logError(QString("Could not open tileset metatiles file '%1'").arg(tileset->metatiles_path));
@@ -1464,22 +1771,17 @@ void Project::loadTilesetMetatiles(Tileset* tileset) {
 
     QFile attrs_file(tileset->metatile_attrs_path);
     if (attrs_file.open(QIODevice::ReadOnly)) {
-        QByteArray data = attrs_file.readAll();
+        const QVector<uint32_t> attributes = Metatile::deserializeAttributes(attrs_file.readAll(), projectConfig.getMetatileAttributesSize());
         int num_metatiles = tileset->metatiles.count();
-        int attrSize = projectConfig.getMetatileAttributesSize();
-        int num_metatileAttrs = data.length() / attrSize;
+        int num_metatileAttrs = attributes.count();
         if (num_metatiles != num_metatileAttrs) {
             logWarn(QString("Metatile count %1 does not match metatile attribute count %2 in %3").arg(num_metatiles).arg(num_metatileAttrs).arg(tileset->name));
             if (num_metatileAttrs > num_metatiles)
                 num_metatileAttrs = num_metatiles;
         }
 
-        for (int i = 0; i < num_metatileAttrs; i++) {
-            uint32_t attributes = 0;
-            for (int j = 0; j < attrSize; j++)
-                attributes |= static_cast<unsigned char>(data.at(i * attrSize + j)) << (8 * j);
-            tileset->metatiles.at(i)->setAttributes(attributes);
-        }
+        for (int i = 0; i < num_metatileAttrs; i++)
+            tileset->metatiles.at(i)->setAttributes(attributes.at(i));
     } else {
         logError(QString("Could not open tileset metatile attributes file '%1'").arg(tileset->metatile_attrs_path));
     }
@@ -1495,11 +1797,12 @@ QString Project::findMetatileLabelsTileset(QString label) {
 }
 
 bool Project::readTilesetMetatileLabels() {
+    PROFILE_SCOPE("Project::readTilesetMetatileLabels");
     metatileLabelsMap.clear();
     unusedMetatileLabels.clear();
 
     QString metatileLabelsFilename = projectConfig.getFilePath(ProjectFilePath::constants_metatile_labels);
-    fileWatcher.addPath(root + "/" + metatileLabelsFilename);
+    watchFile(root + "/" + metatileLabelsFilename, &Project::readTilesetMetatileLabels);
 
     const QStringList prefixes = {QString("\\b%1").arg(projectConfig.getIdentifier(ProjectIdentifier::define_metatile_label_prefix))};
     QMap<QString, int> defines = parser.readCDefinesByPrefix(metatileLabelsFilename, prefixes);
@@ -1524,6 +1827,7 @@ bool Project::readTilesetMetatileLabels() {
 }
 
 void Project::loadTilesetMetatileLabels(Tileset* tileset) {
+    PROFILE_SCOPE("Project::loadTilesetMetatileLabels");
     QString metatileLabelPrefix = tileset->getMetatileLabelPrefix();
 
     // Reverse map for faster lookup by metatile id
@@ -1534,14 +1838,13 @@ void Project::loadTilesetMetatileLabels(Tileset* tileset) {
 }
 
 Blockdata Project::readBlockdata(QString path) {
+    PROFILE_SCOPE("Project::readBlockdata");
     Blockdata blockdata;
     QFile file(path);
     if (file.open(QIODevice::ReadOnly)) {
-        QByteArray data = file.readAll();
-        for (int i = 0; (i + 1) < data.length(); i += 2) {
-            uint16_t word = static_cast<uint16_t>((data[i] & 0xff) + ((data[i + 1] & 0xff) << 8));
-            blockdata.append(word);
-        }
+        const QByteArray data = file.readAll();
+        Profiling::addBytes("Project::readBlockdata", data.size());
+        blockdata = Blockdata::deserialize(data);
     } else {
         logError(QString("Failed to open blockdata path '%1'").arg(path));
     }
@@ -1564,20 +1867,27 @@ Tileset* Project::getTileset(QString label, bool forceLoad) {
         existingTileset = tilesetCache.value(label);
     }
 
+    Profiling::addCacheResult("Project::getTileset", existingTileset && !forceLoad);
     if (existingTileset && !forceLoad) {
         return existingTileset;
     } else {
+        if (existingTileset) {
+            // The tileset is reloaded in place, so images and connection strips rendered with it would be out of date.
+            for (Map *map : mapCache) {
+                map->clearPrerenderedImages();
+                map->clearConnectionCache();
+            }
+        }
         Tileset *tileset = loadTileset(label, existingTileset);
         return tileset;
     }
 }
 
 void Project::saveTextFile(QString path, QString text) {
-    QFile file(path);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(text.toUtf8());
-    } else {
-        logError(QString("Could not open '%1' for writing: ").arg(path) + file.errorString());
+    PROFILE_SCOPE("Project::saveTextFile");
+    QString error;
+    if (!FileUtil::writeIfChanged(path, text.toUtf8(), &error)) {
+        logError(QString("Could not open '%1' for writing: ").arg(path) + error);
     }
 }
 
@@ -1598,6 +1908,7 @@ void Project::deleteFile(QString path) {
 }
 
 bool Project::readWildMonData() {
+    PROFILE_SCOPE("Project::readWildMonData");
     extraEncounterGroups.clear();
     wildMonFields.clear();
     wildMonData.clear();
@@ -1608,10 +1919,10 @@ bool Project::readWildMonData() {
     }
 
     QString wildMonJsonFilepath = QString("%1/%2").arg(root).arg(projectConfig.getFilePath(ProjectFilePath::json_wild_encounters));
-    fileWatcher.addPath(wildMonJsonFilepath);
+    watchFile(wildMonJsonFilepath);
 
-    OrderedJson::object wildMonObj;
-    if (!parser.tryParseOrderedJsonFile(&wildMonObj, wildMonJsonFilepath)) {
+    OrderedJson wildMonJson;
+    if (!parser.tryParseOrderedJsonFile(&wildMonJson, wildMonJsonFilepath)) {
         // Failing to read wild encounters data is not a critical error, the encounter editor will just be disabled
         logWarn(QString("Failed to read wild encounters from %1").arg(wildMonJsonFilepath));
         return true;
@@ -1621,66 +1932,62 @@ bool Project::readWildMonData() {
     // The most common value will be used as the default for new groups.
     QMap<QString, QMap<int, int>> encounterRateFrequencyMaps;
 
-    for (OrderedJson subObjectRef : wildMonObj["wild_encounter_groups"].array_items()) {
-        OrderedJson::object subObject = subObjectRef.object_items();
+    // The JSON is only read through const references, to avoid copying any of its objects.
+    for (const OrderedJson &subObject : wildMonJson["wild_encounter_groups"].array_items()) {
         if (!subObject["for_maps"].bool_value()) {
-            extraEncounterGroups.push_back(subObject);
+            extraEncounterGroups.push_back(subObject.object_items());
             continue;
         }
 
-        for (OrderedJson field : subObject["fields"].array_items()) {
+        for (const OrderedJson &fieldJson : subObject["fields"].array_items()) {
             EncounterField encounterField;
-            OrderedJson::object fieldObj = field.object_items();
-            encounterField.name = fieldObj["type"].string_value();
-            for (auto val : fieldObj["encounter_rates"].array_items()) {
+            encounterField.name = fieldJson["type"].string_value();
+            for (const OrderedJson &val : fieldJson["encounter_rates"].array_items()) {
                 encounterField.encounterRates.append(val.int_value());
             }
 
-            QList<QString> subGroups;
-            for (auto groupPair : fieldObj["groups"].object_items()) {
-                subGroups.append(groupPair.first);
-            }
-            for (QString group : subGroups) {
-                OrderedJson::object groupsObj = fieldObj["groups"].object_items();
-                for (auto slotNum : groupsObj[group].array_items()) {
-                    encounterField.groups[group].append(slotNum.int_value());
+            for (const auto &groupPair : fieldJson["groups"].object_items()) {
+                QVector<int> &slots = encounterField.groups[groupPair.first];
+                for (const OrderedJson &slotNum : groupPair.second.array_items()) {
+                    slots.append(slotNum.int_value());
                 }
             }
             encounterRateFrequencyMaps.insert(encounterField.name, QMap<int, int>());
             wildMonFields.append(encounterField);
         }
 
-        auto encounters = subObject["encounters"].array_items();
-        for (auto encounter : encounters) {
-            OrderedJson::object encounterObj = encounter.object_items();
-            QString mapConstant = encounterObj["map"].string_value();
+        for (const OrderedJson &encounter : subObject["encounters"].array_items()) {
+            const QString mapConstant = encounter["map"].string_value();
 
             WildPokemonHeader header;
 
-            for (EncounterField monField : wildMonFields) {
-                QString field = monField.name;
-                if (!encounterObj[field].is_null()) {
-                    OrderedJson::object encounterFieldObj = encounterObj[field].object_items();
-                    header.wildMons[field].active = true;
-                    header.wildMons[field].encounterRate = encounterFieldObj["encounter_rate"].int_value();
-                    encounterRateFrequencyMaps[field][header.wildMons[field].encounterRate]++;
-                    for (auto mon : encounterFieldObj["mons"].array_items()) {
+            for (const EncounterField &monField : wildMonFields) {
+                const QString &field = monField.name;
+                const OrderedJson &encounterFieldJson = encounter[field];
+                if (!encounterFieldJson.is_null()) {
+                    WildMonInfo &monInfo = header.wildMons[field];
+                    monInfo.active = true;
+                    monInfo.encounterRate = encounterFieldJson["encounter_rate"].int_value();
+                    encounterRateFrequencyMaps[field][monInfo.encounterRate]++;
+                    const OrderedJson::array &mons = encounterFieldJson["mons"].array_items();
+                    monInfo.wildPokemon.reserve(qMax(static_cast<int>(mons.size()), static_cast<int>(monField.encounterRates.length())));
+                    for (const OrderedJson &mon : mons) {
                         WildPokemon newMon;
-                        OrderedJson::object monObj = mon.object_items();
-                        newMon.minLevel = monObj["min_level"].int_value();
-                        newMon.maxLevel = monObj["max_level"].int_value();
-                        newMon.species = monObj["species"].string_value();
-                        header.wildMons[field].wildPokemon.append(newMon);
+                        newMon.minLevel = mon["min_level"].int_value();
+                        newMon.maxLevel = mon["max_level"].int_value();
+                        newMon.species = mon["species"].string_value();
+                        monInfo.wildPokemon.append(newMon);
                     }
                     // If the user supplied too few pokémon for this group then we fill in the rest.
-                    for (int i = header.wildMons[field].wildPokemon.length(); i < monField.encounterRates.length(); i++) {
+                    for (int i = monInfo.wildPokemon.length(); i < monField.encounterRates.length(); i++) {
                         WildPokemon newMon; // Keep default values
-                        header.wildMons[field].wildPokemon.append(newMon);
+                        monInfo.wildPokemon.append(newMon);
                     }
                 }
             }
-            wildMonData[mapConstant].insert({encounterObj["base_label"].string_value(), header});
-            encounterGroupLabels.append(encounterObj["base_label"].string_value());
+            const QString &baseLabel = encounter["base_label"].string_value();
+            wildMonData[mapConstant].insert({baseLabel, header});
+            encounterGroupLabels.append(baseLabel);
         }
     }
 
@@ -1705,6 +2012,7 @@ bool Project::readWildMonData() {
 }
 
 bool Project::readMapGroups() {
+    PROFILE_SCOPE("Project::readMapGroups");
     this->mapConstantsToMapNames.clear();
     this->mapNamesToMapConstants.clear();
     this->mapGroups.clear();
@@ -1713,7 +2021,7 @@ bool Project::readMapGroups() {
     this->mapNames.clear();
 
     const QString filepath = root + "/" + projectConfig.getFilePath(ProjectFilePath::json_map_groups);
-    fileWatcher.addPath(filepath);
+    watchFile(filepath);
     QJsonDocument mapGroupsDoc;
     if (!parser.tryParseJsonFile(&mapGroupsDoc, filepath)) {
         logError(QString("Failed to read map groups from %1").arg(filepath));
@@ -1845,6 +2153,7 @@ void Project::appendTilesetLabel(QString label, QString isSecondaryStr) {
 }
 
 bool Project::readTilesetLabels() {
+    PROFILE_SCOPE("Project::readTilesetLabels");
     QStringList primaryTilesets;
     QStringList secondaryTilesets;
     this->primaryTilesetLabels.clear();
@@ -1895,6 +2204,7 @@ bool Project::readTilesetLabels() {
 }
 
 bool Project::readFieldmapProperties() {
+    PROFILE_SCOPE("Project::readFieldmapProperties");
     const QString numTilesPrimaryName = projectConfig.getIdentifier(ProjectIdentifier::define_tiles_primary);
     const QString numTilesTotalName = projectConfig.getIdentifier(ProjectIdentifier::define_tiles_total);
     const QString numMetatilesPrimaryName = projectConfig.getIdentifier(ProjectIdentifier::define_metatiles_primary);
@@ -1910,7 +2220,7 @@ bool Project::readFieldmapProperties() {
         maxMapSizeName,
     };
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_fieldmap);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename);
     const QMap<QString, int> defines = parser.readCDefinesByName(filename, names);
 
     auto loadDefine = [defines](const QString name, int * dest) {
@@ -1953,6 +2263,7 @@ bool Project::readFieldmapProperties() {
 
 // Read data masks for Blocks and metatile attributes.
 bool Project::readFieldmapMasks() {
+    PROFILE_SCOPE("Project::readFieldmapMasks");
     const QString metatileIdMaskName = projectConfig.getIdentifier(ProjectIdentifier::define_mask_metatile);
     const QString collisionMaskName = projectConfig.getIdentifier(ProjectIdentifier::define_mask_collision);
     const QString elevationMaskName = projectConfig.getIdentifier(ProjectIdentifier::define_mask_elevation);
@@ -1966,7 +2277,7 @@ bool Project::readFieldmapMasks() {
         layerTypeMaskName,
     };
     QString globalFieldmap = projectConfig.getFilePath(ProjectFilePath::global_fieldmap);
-    fileWatcher.addPath(root + "/" + globalFieldmap);
+    watchFile(root + "/" + globalFieldmap);
     QMap<QString, int> defines = parser.readCDefinesByName(globalFieldmap, searchNames);
 
     // These mask values are accessible via the settings editor for users who don't have these defines.
@@ -2017,7 +2328,7 @@ bool Project::readFieldmapMasks() {
         const QString layerTypeTableName = projectConfig.getIdentifier(ProjectIdentifier::define_attribute_layer);
         const QString encounterTypeTableName = projectConfig.getIdentifier(ProjectIdentifier::define_attribute_encounter);
         const QString terrainTypeTableName = projectConfig.getIdentifier(ProjectIdentifier::define_attribute_terrain);
-        fileWatcher.addPath(root + "/" + srcFieldmap);
+        watchFile(root + "/" + srcFieldmap);
 
         bool ok;
         // Read terrain type mask
@@ -2055,12 +2366,13 @@ bool Project::readFieldmapMasks() {
 }
 
 bool Project::readRegionMapSections() {
+    PROFILE_SCOPE("Project::readRegionMapSections");
     this->mapSectionNameToValue.clear();
     this->mapSectionValueToName.clear();
 
     const QStringList prefixes = {QString("\\b%1").arg(projectConfig.getIdentifier(ProjectIdentifier::define_map_section_prefix))};
     QString filename = projectConfig.getFilePath(ProjectFilePath::constants_region_map_sections);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readRegionMapSections);
     this->mapSectionNameToValue = parser.readCDefinesByPrefix(filename, prefixes);
     if (this->mapSectionNameToValue.isEmpty()) {
         logError(QString("Failed to read region map sections from %1.").arg(filename));
@@ -2075,13 +2387,14 @@ bool Project::readRegionMapSections() {
 
 // Read the constants to preserve any "unused" heal locations when writing the file later
 bool Project::readHealLocationConstants() {
+    PROFILE_SCOPE("Project::readHealLocationConstants");
     this->healLocationNameToValue.clear();
     const QStringList prefixes = {
         QString("\\b%1").arg(projectConfig.getIdentifier(ProjectIdentifier::define_heal_locations_prefix)),
         QString("\\b%1").arg(projectConfig.getIdentifier(ProjectIdentifier::define_spawn_prefix))
     };
     QString constantsFilename = projectConfig.getFilePath(ProjectFilePath::constants_heal_locations);
-    fileWatcher.addPath(root + "/" + constantsFilename);
+    watchFile(root + "/" + constantsFilename);
     this->healLocationNameToValue = parser.readCDefinesByPrefix(constantsFilename, prefixes);
     // No need to check if empty, not finding any heal location constants is ok
     return true;
@@ -2089,13 +2402,15 @@ bool Project::readHealLocationConstants() {
 
 // TODO: Simplify using the new C struct parsing functions (and indexed array parsing functions)
 bool Project::readHealLocations() {
+    PROFILE_SCOPE("Project::readHealLocations");
     this->healLocations.clear();
+    this->healLocationsByMap.clear();
 
     if (!this->readHealLocationConstants())
         return false;
 
     QString filename = projectConfig.getFilePath(ProjectFilePath::data_heal_locations);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename);
     QString text = parser.readTextFile(root + "/" + filename);
 
     // Strip comments
@@ -2175,15 +2490,17 @@ bool Project::readHealLocations() {
         }
 
         this->healLocations.append(healLocation);
+        this->indexHealLocation(this->healLocations.length() - 1);
     }
     // No need to check if empty, not finding any heal locations is ok
     return true;
 }
 
 bool Project::readItemNames() {
+    PROFILE_SCOPE("Project::readItemNames");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_items)};  
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_items);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readItemNames);
     itemNames = parser.readCDefineNames(filename, prefixes);
     if (itemNames.isEmpty())
         logWarn(QString("Failed to read item constants from %1").arg(filename));
@@ -2191,9 +2508,10 @@ bool Project::readItemNames() {
 }
 
 bool Project::readFlagNames() {
+    PROFILE_SCOPE("Project::readFlagNames");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_flags)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_flags);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readFlagNames);
     flagNames = parser.readCDefineNames(filename, prefixes);
     if (flagNames.isEmpty())
         logWarn(QString("Failed to read flag constants from %1").arg(filename));
@@ -2201,9 +2519,10 @@ bool Project::readFlagNames() {
 }
 
 bool Project::readVarNames() {
+    PROFILE_SCOPE("Project::readVarNames");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_vars)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_vars);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readVarNames);
     varNames = parser.readCDefineNames(filename, prefixes);
     if (varNames.isEmpty())
         logWarn(QString("Failed to read var constants from %1").arg(filename));
@@ -2211,9 +2530,10 @@ bool Project::readVarNames() {
 }
 
 bool Project::readMovementTypes() {
+    PROFILE_SCOPE("Project::readMovementTypes");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_movement_types)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_obj_event_movement);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readMovementTypes);
     movementTypes = parser.readCDefineNames(filename, prefixes);
     if (movementTypes.isEmpty())
         logWarn(QString("Failed to read movement type constants from %1").arg(filename));
@@ -2221,8 +2541,9 @@ bool Project::readMovementTypes() {
 }
 
 bool Project::readInitialFacingDirections() {
+    PROFILE_SCOPE("Project::readInitialFacingDirections");
     QString filename = projectConfig.getFilePath(ProjectFilePath::initial_facing_table);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readInitialFacingDirections);
     facingDirections = parser.readNamedIndexCArray(filename, projectConfig.getIdentifier(ProjectIdentifier::symbol_facing_directions));
     if (facingDirections.isEmpty())
         logWarn(QString("Failed to read initial movement type facing directions from %1").arg(filename));
@@ -2230,9 +2551,10 @@ bool Project::readInitialFacingDirections() {
 }
 
 bool Project::readMapTypes() {
+    PROFILE_SCOPE("Project::readMapTypes");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_map_types)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_map_types);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readMapTypes);
     mapTypes = parser.readCDefineNames(filename, prefixes);
     if (mapTypes.isEmpty())
         logWarn(QString("Failed to read map type constants from %1").arg(filename));
@@ -2240,9 +2562,10 @@ bool Project::readMapTypes() {
 }
 
 bool Project::readMapBattleScenes() {
+    PROFILE_SCOPE("Project::readMapBattleScenes");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_battle_scenes)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_map_types);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readMapBattleScenes);
     mapBattleScenes = parser.readCDefineNames(filename, prefixes);
     if (mapBattleScenes.isEmpty())
         logWarn(QString("Failed to read map battle scene constants from %1").arg(filename));
@@ -2250,9 +2573,10 @@ bool Project::readMapBattleScenes() {
 }
 
 bool Project::readWeatherNames() {
+    PROFILE_SCOPE("Project::readWeatherNames");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_weather)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_weather);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readWeatherNames);
     weatherNames = parser.readCDefineNames(filename, prefixes);
     if (weatherNames.isEmpty())
         logWarn(QString("Failed to read weather constants from %1").arg(filename));
@@ -2260,12 +2584,13 @@ bool Project::readWeatherNames() {
 }
 
 bool Project::readCoordEventWeatherNames() {
+    PROFILE_SCOPE("Project::readCoordEventWeatherNames");
     if (!projectConfig.getEventWeatherTriggerEnabled())
         return true;
 
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_coord_event_weather)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_weather);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readCoordEventWeatherNames);
     coordEventWeatherNames = parser.readCDefineNames(filename, prefixes);
     if (coordEventWeatherNames.isEmpty())
         logWarn(QString("Failed to read coord event weather constants from %1").arg(filename));
@@ -2273,12 +2598,13 @@ bool Project::readCoordEventWeatherNames() {
 }
 
 bool Project::readSecretBaseIds() {
+    PROFILE_SCOPE("Project::readSecretBaseIds");
     if (!projectConfig.getEventSecretBaseEnabled())
         return true;
 
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_secret_bases)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_secret_bases);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readSecretBaseIds);
     secretBaseIds = parser.readCDefineNames(filename, prefixes);
     if (secretBaseIds.isEmpty())
         logWarn(QString("Failed to read secret base id constants from '%1'").arg(filename));
@@ -2286,9 +2612,10 @@ bool Project::readSecretBaseIds() {
 }
 
 bool Project::readBgEventFacingDirections() {
+    PROFILE_SCOPE("Project::readBgEventFacingDirections");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_sign_facing_directions)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_event_bg);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readBgEventFacingDirections);
     bgEventFacingDirections = parser.readCDefineNames(filename, prefixes);
     if (bgEventFacingDirections.isEmpty())
         logWarn(QString("Failed to read bg event facing direction constants from %1").arg(filename));
@@ -2296,9 +2623,10 @@ bool Project::readBgEventFacingDirections() {
 }
 
 bool Project::readTrainerTypes() {
+    PROFILE_SCOPE("Project::readTrainerTypes");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_trainer_types)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_trainer_types);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readTrainerTypes);
     trainerTypes = parser.readCDefineNames(filename, prefixes);
     if (trainerTypes.isEmpty())
         logWarn(QString("Failed to read trainer type constants from %1").arg(filename));
@@ -2306,12 +2634,13 @@ bool Project::readTrainerTypes() {
 }
 
 bool Project::readMetatileBehaviors() {
+    PROFILE_SCOPE("Project::readMetatileBehaviors");
     this->metatileBehaviorMap.clear();
     this->metatileBehaviorMapInverse.clear();
 
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_behaviors)};
     QString filename = projectConfig.getFilePath(ProjectFilePath::constants_metatile_behaviors);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readMetatileBehaviors);
     QMap<QString, int> defines = parser.readCDefinesByPrefix(filename, prefixes);
     if (defines.isEmpty()) {
         // Not having any metatile behavior names is ok (their values will be displayed instead).
@@ -2331,9 +2660,10 @@ bool Project::readMetatileBehaviors() {
 }
 
 bool Project::readSongNames() {
+    PROFILE_SCOPE("Project::readSongNames");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_music)};
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_songs);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename, &Project::readSongNames);
     this->songNames = parser.readCDefineNames(filename, prefixes);
     if (this->songNames.isEmpty())
         logWarn(QString("Failed to read song names from %1.").arg(filename));
@@ -2346,9 +2676,10 @@ bool Project::readSongNames() {
 }
 
 bool Project::readObjEventGfxConstants() {
+    PROFILE_SCOPE("Project::readObjEventGfxConstants");
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_obj_event_gfx)};
     QString filename = projectConfig.getFilePath(ProjectFilePath::constants_obj_events);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename);
     this->gfxDefines = parser.readCDefinesByPrefix(filename, prefixes);
     if (this->gfxDefines.isEmpty())
         logWarn(QString("Failed to read object event graphics constants from %1.").arg(filename));
@@ -2356,12 +2687,13 @@ bool Project::readObjEventGfxConstants() {
 }
 
 bool Project::readMiscellaneousConstants() {
+    PROFILE_SCOPE("Project::readMiscellaneousConstants");
     miscConstants.clear();
     if (userConfig.getEncounterJsonActive()) {
         const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_pokemon);
         const QString minLevelName = projectConfig.getIdentifier(ProjectIdentifier::define_min_level);
         const QString maxLevelName = projectConfig.getIdentifier(ProjectIdentifier::define_max_level);
-        fileWatcher.addPath(root + "/" + filename);
+        watchFile(root + "/" + filename);
         QMap<QString, int> pokemonDefines = parser.readCDefinesByName(filename, {minLevelName, maxLevelName});
         miscConstants.insert("max_level_define", pokemonDefines.value(maxLevelName) > pokemonDefines.value(minLevelName) ? pokemonDefines.value(maxLevelName) : 100);
         miscConstants.insert("min_level_define", pokemonDefines.value(minLevelName) < pokemonDefines.value(maxLevelName) ? pokemonDefines.value(minLevelName) : 1);
@@ -2369,7 +2701,7 @@ bool Project::readMiscellaneousConstants() {
 
     const QString filename = projectConfig.getFilePath(ProjectFilePath::constants_global);
     const QString maxObjectEventsName = projectConfig.getIdentifier(ProjectIdentifier::define_obj_event_count);
-    fileWatcher.addPath(root + "/" + filename);
+    watchFile(root + "/" + filename);
     QMap<QString, int> defines = parser.readCDefinesByName(filename, {maxObjectEventsName});
 
     auto it = defines.find(maxObjectEventsName);
@@ -2392,10 +2724,46 @@ bool Project::readMiscellaneousConstants() {
     return true;
 }
 
+// Script labels are indexed by the file and line they're defined on. Each time this is called
+// only the script files that are new or have been modified since they were last read are scanned,
+// and those are scanned concurrently.
 bool Project::readEventScriptLabels() {
+    PROFILE_SCOPE("Project::readEventScriptLabels");
+    struct ScriptFileData {
+        QString filePath;
+        ScriptFile file;
+    };
+
+    const QStringList filePaths = getEventScriptsFilePaths();
+    QHash<QString, ScriptFile> files;
+    QVector<ScriptFileData> changedFiles;
+    for (const auto &filePath : filePaths) {
+        const QFileInfo info(filePath);
+        auto it = this->scriptFiles.constFind(filePath);
+        if (it != this->scriptFiles.constEnd() && it->lastModified == info.lastModified() && it->size == info.size()) {
+            files.insert(filePath, it.value());
+        } else {
+            changedFiles.append({filePath, {info.lastModified(), info.size(), {}}});
+        }
+    }
+
+    QtConcurrent::blockingMap(changedFiles, [](ScriptFileData &data) {
+        data.file.labels = ParseUtil::readScriptLabels(data.filePath);
+    });
+    for (const auto &data : changedFiles)
+        files.insert(data.filePath, data.file);
+    this->scriptFiles = files;
+
+    // Rebuild the label index. If a label is defined more than once the locations are kept in file order.
+    this->scriptLabelLocations.clear();
     globalScriptLabels.clear();
-    for (const auto &filePath : getEventScriptsFilePaths())
-        globalScriptLabels << ParseUtil::getGlobalScriptLabels(filePath);
+    for (const auto &filePath : filePaths) {
+        for (const auto &label : this->scriptFiles[filePath].labels) {
+            this->scriptLabelLocations[label.name].append({filePath, label.lineNumber});
+            if (label.global)
+                globalScriptLabels << label.name;
+        }
+    }
 
     globalScriptLabels.sort(Qt::CaseInsensitive);
     globalScriptLabels.removeDuplicates();
@@ -2403,6 +2771,52 @@ bool Project::readEventScriptLabels() {
     return true;
 }
 
+// Returns the global labels defined in the given script file.
+// The file is re-read if it isn't indexed, or if it has been modified since it was indexed.
+QStringList Project::getGlobalScriptLabels(const QString &filePath) {
+    const QFileInfo info(filePath);
+    QList<ScriptLabel> fileLabels;
+    auto it = this->scriptFiles.find(filePath);
+    if (it != this->scriptFiles.end() && it->lastModified == info.lastModified() && it->size == info.size()) {
+        fileLabels = it->labels;
+    } else {
+        fileLabels = ParseUtil::readScriptLabels(filePath);
+        // The rest of the index is rebuilt from the updated labels the next time it's read.
+        if (it != this->scriptFiles.end())
+            *it = {info.lastModified(), info.size(), fileLabels};
+    }
+
+    QStringList labels;
+    for (const auto &label : fileLabels) {
+        if (label.global)
+            labels << label.name;
+    }
+    return labels;
+}
+
+// Finds the file and line number where a script label is defined, preferring the given file if it's defined there.
+// The index is brought up to date first, in case any script files have been edited.
+bool Project::findScriptLabel(const QString &label, const QString &preferredFilePath, QString *filePath, int *lineNumber) {
+    if (label.isEmpty())
+        return false;
+
+    readEventScriptLabels();
+    const QList<ScriptLabelLocation> locations = this->scriptLabelLocations.value(label);
+    if (locations.isEmpty())
+        return false;
+
+    ScriptLabelLocation location = locations.first();
+    for (const auto &otherLocation : locations) {
+        if (otherLocation.filePath == preferredFilePath) {
+            location = otherLocation;
+            break;
+        }
+    }
+    if (filePath) *filePath = location.filePath;
+    if (lineNumber) *lineNumber = location.lineNumber;
+    return true;
+}
+
 QString Project::fixPalettePath(QString path) {
     static const QRegularExpression re_gbapal("\\.gbapal$");
     path = path.replace(re_gbapal, ".pal");
@@ -2465,15 +2879,18 @@ void Project::setEventPixmap(Event *event, bool forceLoad) {
 }
 
 bool Project::readEventGraphics() {
-    fileWatcher.addPaths(QStringList() << root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx_pointers)
-                                       << root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx_info)
-                                       << root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_pic_tables)
-                                       << root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx));
+    PROFILE_SCOPE("Project::readEventGraphics");
+    watchFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx_pointers));
+    watchFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx_info));
+    watchFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_pic_tables));
+    watchFile(root + "/" + projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx));
 
     const QString pointersFilepath = projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx_pointers);
     const QString pointersName = projectConfig.getIdentifier(ProjectIdentifier::symbol_obj_event_gfx_pointers);
     QMap<QString, QString> pointerHash = parser.readNamedIndexCArray(pointersFilepath, pointersName);
 
+    loadedEventGraphics.clear();
+    loadedEventGraphicsSize = 0;
     qDeleteAll(eventGraphicsMap);
     eventGraphicsMap.clear();
     QStringList gfxNames = gfxDefines.keys();
@@ -2494,12 +2911,11 @@ bool Project::readEventGraphics() {
     QMap<QString, QString> graphicIncbins = parser.readCIncbinMulti(projectConfig.getFilePath(ProjectFilePath::data_obj_event_gfx));
 
     for (QString gfxName : gfxNames) {
-        EventGraphics * eventGraphics = new EventGraphics;
-
         QString info_label = pointerHash[gfxName].replace("&", "");
         if (!gfxInfos.contains(info_label))
             continue;
 
+        EventGraphics * eventGraphics = new EventGraphics;
         const auto gfxInfoAttributes = gfxInfos[info_label];
 
         eventGraphics->inanimate = ParseUtil::gameStringToBool(gfxInfoAttributes.value("inanimate"));
@@ -2513,9 +2929,12 @@ bool Project::readEventGraphics() {
         QString path = graphicIncbins[gfx_label];
 
         if (!path.isNull()) {
-            path = fixGraphicPath(path);
-            eventGraphics->spritesheet = QImage(root + "/" + path);
-            if (!eventGraphics->spritesheet.isNull()) {
+            // Only the image header is read here, the spritesheet is decoded by loadEventGraphics when it's first used.
+            path = root + "/" + fixGraphicPath(path);
+            QImageReader reader(path);
+            const QSize sheetSize = reader.canRead() ? reader.size() : QSize();
+            if (sheetSize.isValid()) {
+                eventGraphics->filepath = path;
                 // Infer the sprite dimensions from the OAM labels.
                 static const QRegularExpression re("\\S+_(\\d+)x(\\d+)");
                 QRegularExpressionMatch dimensionMatch = re.match(dimensions_label);
@@ -2527,12 +2946,11 @@ bool Project::readEventGraphics() {
                     eventGraphics->spriteWidth = dimensionMatch.captured(1).toInt(nullptr, 0);
                     eventGraphics->spriteHeight = dimensionMatch.captured(2).toInt(nullptr, 0);
                 } else {
-                    eventGraphics->spriteWidth = eventGraphics->spritesheet.width();
-                    eventGraphics->spriteHeight = eventGraphics->spritesheet.height();
+                    eventGraphics->spriteWidth = sheetSize.width();
+                    eventGraphics->spriteHeight = sheetSize.height();
                 }
             }
         } else {
-            eventGraphics->spritesheet = QImage();
             eventGraphics->spriteWidth = 16;
             eventGraphics->spriteHeight = 16;
         }
@@ -2541,30 +2959,129 @@ bool Project::readEventGraphics() {
     return true;
 }
 
+// The least recently used spritesheets are freed once the decoded spritesheets exceed this size.
+static const qint64 maxLoadedEventGraphicsSize = 32 * 1024 * 1024;
+
+// Decodes the event graphics' spritesheet if it hasn't been already.
+// Returns false if there is no usable spritesheet.
+bool Project::loadEventGraphics(EventGraphics *gfx) {
+    PROFILE_SCOPE("Project::loadEventGraphics");
+    if (!gfx || gfx->filepath.isEmpty())
+        return false;
+
+    if (gfx->loaded) {
+        if (gfx->spritesheet.isNull())
+            return false;
+        // Mark as most recently used
+        if (loadedEventGraphics.last() != gfx) {
+            loadedEventGraphics.removeOne(gfx);
+            loadedEventGraphics.append(gfx);
+        }
+        return true;
+    }
+
+    gfx->spritesheet = QImage(gfx->filepath);
+    gfx->loaded = true;
+    if (gfx->spritesheet.isNull())
+        return false;
+
+    loadedEventGraphics.append(gfx);
+    loadedEventGraphicsSize += gfx->spritesheet.sizeInBytes();
+    while (loadedEventGraphicsSize > maxLoadedEventGraphicsSize && loadedEventGraphics.length() > 1) {
+        EventGraphics *oldest = loadedEventGraphics.takeFirst();
+        loadedEventGraphicsSize -= oldest->spritesheet.sizeInBytes();
+        oldest->unload();
+    }
+    return true;
+}
+
+// Icons that weren't found in the icon table are looked for in the Pokémon graphics folder.
+// Rather than checking each possible filepath on disk, the folder is scanned once for icon files.
+// This runs on a worker thread, so it only uses the data it's given.
+static QMap<QString, QString> findSpeciesIconPaths(const QString &gfxDir, const QStringList &speciesNames, const QMap<QString, QString> &monIconNames) {
+    // Map each folder containing an icon (relative to the graphics folder, lowercase) to the icon's filepath.
+    QHash<QString, QString> iconDirs;
+    const QDir baseDir(gfxDir);
+    QDirIterator it(gfxDir, QStringList() << "icon.png", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString filepath = it.next();
+        const QString dir = baseDir.relativeFilePath(QFileInfo(filepath).path());
+        iconDirs.insert(dir.toLower(), filepath);
+    }
+
+    QMap<QString, QString> paths;
+    for (const QString &species : speciesNames) {
+        // Try to use the icon name (if we have it) to determine the directory, then try the species name.
+        // The name permuting is overkill, but it's making up for some of the fragility in the way we find icon paths.
+        QStringList possibleDirNames;
+        if (monIconNames.contains(species)) {
+            // Ex: For 'gMonIcon_QuestionMark' try 'question_mark'
+            static const QRegularExpression re("([a-z])([A-Z0-9])");
+            QString iconName = monIconNames.value(species);
+            iconName = iconName.mid(iconName.indexOf("_") + 1); // jump past prefix ('gMonIcon')
+            possibleDirNames.append(iconName.replace(re, "\\1_\\2").toLower());
+        }
+
+        // Ex: For 'SPECIES_FOO_BAR_BAZ' try 'foo_bar_baz'
+        possibleDirNames.append(species.mid(8).toLower());
+
+        // Permute paths with underscores.
+        // Ex: Try 'foo_bar/baz', 'foo/bar_baz', 'foobarbaz', 'foo_bar', and 'foo'
+        QStringList permutedNames;
+        for (auto dir : possibleDirNames) {
+            if (!dir.contains("_")) continue;
+            for (int i = dir.indexOf("_"); i > -1; i = dir.indexOf("_", i + 1)) {
+                QString temp = dir;
+                permutedNames.prepend(temp.replace(i, 1, "/"));
+                permutedNames.append(dir.left(i)); // Prepend the others so the most generic name ('foo') ends up last
+            }
+            permutedNames.prepend(dir.remove("_"));
+        }
+        possibleDirNames.append(permutedNames);
+
+        possibleDirNames.removeDuplicates();
+        QString path;
+        for (const QString &dir : possibleDirNames) {
+            if (dir.isEmpty()) continue;
+            path = iconDirs.value(dir);
+            if (!path.isEmpty()) {
+                // Icon found at a normal filepath
+                break;
+            }
+        }
+        paths.insert(species, path);
+    }
+    return paths;
+}
+
 bool Project::readSpeciesIconPaths() {
+    PROFILE_SCOPE("Project::readSpeciesIconPaths");
     this->speciesToIconPath.clear();
+    this->speciesIcons.clear();
+    this->loadingSpeciesIcons.clear();
+    this->speciesIconsGeneration++;
 
     // Read map of species constants to icon names
     const QString srcfilename = projectConfig.getFilePath(ProjectFilePath::pokemon_icon_table);
-    fileWatcher.addPath(root + "/" + srcfilename);
+    watchFile(root + "/" + srcfilename, &Project::readSpeciesIconPaths);
     const QString tableName = projectConfig.getIdentifier(ProjectIdentifier::symbol_pokemon_icon_table);
     const QMap<QString, QString> monIconNames = parser.readNamedIndexCArray(srcfilename, tableName);
 
     // Read map of icon names to filepaths
     const QString incfilename = projectConfig.getFilePath(ProjectFilePath::data_pokemon_gfx);
-    fileWatcher.addPath(root + "/" + incfilename);
+    watchFile(root + "/" + incfilename, &Project::readSpeciesIconPaths);
     const QMap<QString, QString> iconIncbins = parser.readCIncbinMulti(incfilename);
 
     // Read species constants. If this fails we can get them from the icon table (but we shouldn't rely on it).
     const QStringList prefixes = {projectConfig.getIdentifier(ProjectIdentifier::regex_species)};
     const QString constantsFilename = projectConfig.getFilePath(ProjectFilePath::constants_species);
-    fileWatcher.addPath(root + "/" + constantsFilename);
+    watchFile(root + "/" + constantsFilename, &Project::readSpeciesIconPaths);
     QStringList speciesNames = parser.readCDefineNames(constantsFilename, prefixes);
     if (speciesNames.isEmpty())
         speciesNames = monIconNames.keys();
 
     // For each species, use the information gathered above to find the icon image.
-    bool missingIcons = false;
+    QStringList unresolvedSpecies;
     for (auto species : speciesNames) {
         QString path = QString();
         if (monIconNames.contains(species) && iconIncbins.contains(monIconNames.value(species))) {
@@ -2572,61 +3089,92 @@ bool Project::readSpeciesIconPaths() {
             path = QString("%1/%2").arg(root).arg(this->fixGraphicPath(iconIncbins[monIconNames.value(species)]));
         } else {
             // Failed to read icon filepath from the icon table, check filepaths where icons are normally located.
-            // Try to use the icon name (if we have it) to determine the directory, then try the species name.
-            // The name permuting is overkill, but it's making up for some of the fragility in the way we find icon paths.
-            QStringList possibleDirNames;
-            if (monIconNames.contains(species)) {
-                // Ex: For 'gMonIcon_QuestionMark' try 'question_mark'
-                static const QRegularExpression re("([a-z])([A-Z0-9])");
-                QString iconName = monIconNames.value(species);
-                iconName = iconName.mid(iconName.indexOf("_") + 1); // jump past prefix ('gMonIcon')
-                possibleDirNames.append(iconName.replace(re, "\\1_\\2").toLower());
-            }
+            unresolvedSpecies.append(species);
+        }
+        this->speciesToIconPath.insert(species, path);
+    }
 
-            // Ex: For 'SPECIES_FOO_BAR_BAZ' try 'foo_bar_baz'
-            possibleDirNames.append(species.mid(8).toLower());
-
-            // Permute paths with underscores.
-            // Ex: Try 'foo_bar/baz', 'foo/bar_baz', 'foobarbaz', 'foo_bar', and 'foo'
-            QStringList permutedNames;
-            for (auto dir : possibleDirNames) {
-                if (!dir.contains("_")) continue;
-                for (int i = dir.indexOf("_"); i > -1; i = dir.indexOf("_", i + 1)) {
-                    QString temp = dir;
-                    permutedNames.prepend(temp.replace(i, 1, "/"));
-                    permutedNames.append(dir.left(i)); // Prepend the others so the most generic name ('foo') ends up last
-                }
-                permutedNames.prepend(dir.remove("_"));
-            }
-            possibleDirNames.append(permutedNames);
-
-            possibleDirNames.removeDuplicates();
-            for (auto dir : possibleDirNames) {
-                if (dir.isEmpty()) continue;
-                const QString stdPath = QString("%1/%2%3/icon.png")
-                                                .arg(root)
-                                                .arg(projectConfig.getFilePath(ProjectFilePath::pokemon_gfx))
-                                                .arg(dir);
-                if (QFile::exists(stdPath)) {
-                    // Icon found at a normal filepath
-                    path = stdPath;
-                    break;
-                }
-            }
+    // Searching for the remaining icons can take a while for projects with many species,
+    // so it continues in the background until the icon paths are first needed (see getSpeciesIconPaths).
+    this->readingSpeciesIconPaths = !unresolvedSpecies.isEmpty();
+    if (this->readingSpeciesIconPaths) {
+        const QString gfxDir = QString("%1/%2").arg(root).arg(projectConfig.getFilePath(ProjectFilePath::pokemon_gfx));
+        this->speciesIconPathsFuture = QtConcurrent::run([gfxDir, unresolvedSpecies, monIconNames] {
+            return findSpeciesIconPaths(gfxDir, unresolvedSpecies, monIconNames);
+        });
+    }
 
-            if (path.isEmpty() && projectConfig.getPokemonIconPath(species).isEmpty()) {
-                // Failed to find icon, this species will use a placeholder icon.
-                logWarn(QString("Failed to find Pokémon icon for '%1'").arg(species));
-                missingIcons = true;
-            }
+    return true;
+}
+
+const QMap<QString, QString> &Project::getSpeciesIconPaths() {
+    if (!this->readingSpeciesIconPaths)
+        return this->speciesToIconPath;
+    this->readingSpeciesIconPaths = false;
+
+    bool missingIcons = false;
+    const QMap<QString, QString> foundPaths = this->speciesIconPathsFuture.result();
+    for (auto it = foundPaths.constBegin(); it != foundPaths.constEnd(); it++) {
+        const QString &species = it.key();
+        if (it.value().isEmpty() && projectConfig.getPokemonIconPath(species).isEmpty()) {
+            // Failed to find icon, this species will use a placeholder icon.
+            logWarn(QString("Failed to find Pokémon icon for '%1'").arg(species));
+            missingIcons = true;
         }
-        this->speciesToIconPath.insert(species, path);
+        this->speciesToIconPath.insert(species, it.value());
     }
+    this->speciesIconPathsFuture = QFuture<QMap<QString, QString>>();
 
     // Logging this alongside every warning (if there are multiple) is obnoxious, just do it once at the end.
     if (missingIcons) logInfo("Pokémon icon filepaths can be specified under 'Options->Project Settings'");
 
-    return true;
+    return this->speciesToIconPath;
+}
+
+// Returns the 32x32 icon for the given species. Icons are decoded in the background, so this returns a
+// null pixmap if the icon isn't ready yet, and speciesIconLoaded is emitted once it is.
+QPixmap Project::getSpeciesIcon(const QString &species) {
+    auto it = this->speciesIcons.constFind(species);
+    Profiling::addCacheResult("Project::getSpeciesIcon", it != this->speciesIcons.constEnd());
+    if (it != this->speciesIcons.constEnd())
+        return it.value();
+    if (this->loadingSpeciesIcons.contains(species))
+        return QPixmap();
+    this->loadingSpeciesIcons.insert(species);
+
+    // Prefer path from config. If not present, use the path parsed from project files
+    QString path = projectConfig.getPokemonIconPath(species);
+    if (path.isEmpty()) {
+        path = this->getSpeciesIconPaths().value(species);
+    } else {
+        path = Project::getExistingFilepath(path);
+    }
+
+    auto watcher = new QFutureWatcher<QImage>(this);
+    const int generation = this->speciesIconsGeneration;
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, species, generation] {
+        const QImage image = watcher->result();
+        watcher->deleteLater();
+
+        // The icons may have been reset while this one was loading, in which case it may be from an old path.
+        if (generation != this->speciesIconsGeneration)
+            return;
+        this->loadingSpeciesIcons.remove(species);
+        this->speciesIcons.insert(species, QPixmap::fromImage(image));
+        emit speciesIconLoaded(species);
+    });
+    watcher->setFuture(QtConcurrent::run([path] {
+        QImage image(path);
+        if (image.isNull()) {
+            // No icon for this species, use placeholder
+            image = QImage(":images/pokemon_icon_placeholder.png");
+        } else {
+            image.setColor(0, qRgba(0, 0, 0, 0));
+        }
+        // Icon images have two frames, only the first is displayed.
+        return image.copy(0, 0, 32, 32);
+    }));
+    return QPixmap();
 }
 
 void Project::setNewMapEvents(Map *map) {
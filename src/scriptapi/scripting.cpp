@@ -1,5 +1,6 @@
 #include "scripting.h"
 #include "log.h"
+#include "profiling.h"
 #include "config.h"
 #include "aboutporymap.h"
 
@@ -20,6 +21,24 @@ QMap<CallbackType, QString> callbackFunctions = {
     {OnBorderVisibilityToggled, "onBorderVisibilityToggled"},
 };
 
+// Callbacks are profiled under these names, so that no string has to be built each time a callback is invoked.
+const QMap<CallbackType, const char*> callbackTimerNames = {
+    {OnProjectOpened, "Script callback onProjectOpened"},
+    {OnProjectClosed, "Script callback onProjectClosed"},
+    {OnBlockChanged, "Script callback onBlockChanged"},
+    {OnBorderMetatileChanged, "Script callback onBorderMetatileChanged"},
+    {OnBlockHoverChanged, "Script callback onBlockHoverChanged"},
+    {OnBlockHoverCleared, "Script callback onBlockHoverCleared"},
+    {OnMapOpened, "Script callback onMapOpened"},
+    {OnMapResized, "Script callback onMapResized"},
+    {OnBorderResized, "Script callback onBorderResized"},
+    {OnMapShifted, "Script callback onMapShifted"},
+    {OnTilesetUpdated, "Script callback onTilesetUpdated"},
+    {OnMainTabChanged, "Script callback onMainTabChanged"},
+    {OnMapViewTabChanged, "Script callback onMapViewTabChanged"},
+    {OnBorderVisibilityToggled, "Script callback onBorderVisibilityToggled"},
+};
+
 Scripting *instance = nullptr;
 
 void Scripting::init(MainWindow *mainWindow) {
@@ -145,8 +164,11 @@ bool Scripting::tryErrorJS(QJSValue js) {
 }
 
 void Scripting::invokeCallback(CallbackType type, QJSValueList args) {
+    if (this->modules.isEmpty())
+        return;
+    ScopedTimer timer(callbackTimerNames.value(type, "Script callback"));
+    QString functionName = callbackFunctions[type];
     for (QJSValue module : this->modules) {
-        QString functionName = callbackFunctions[type];
         QJSValue callbackFunction = module.property(functionName);
         if (tryErrorJS(callbackFunction)) continue;
 
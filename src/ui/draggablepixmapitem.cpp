@@ -33,6 +33,26 @@ void DraggablePixmapItem::updatePixmap() {
     emit spriteChanged(event->getPixmap());
 }
 
+// The outline for selected events is drawn over the event's pixmap,
+// so the pixmap itself can be shared with every other event using the same sprite.
+void DraggablePixmapItem::setSelectionOutline(bool enabled) {
+    if (this->selectionOutline == enabled)
+        return;
+    this->selectionOutline = enabled;
+    update();
+}
+
+void DraggablePixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    QGraphicsPixmapItem::paint(painter, option, widget);
+    if (this->selectionOutline) {
+        const QPixmap pixmap = this->pixmap();
+        painter->save();
+        painter->setPen(QColor(255, 0, 255));
+        painter->drawRect(0, 0, pixmap.width() - 1, pixmap.height() - 1);
+        painter->restore();
+    }
+}
+
 void DraggablePixmapItem::mousePressEvent(QGraphicsSceneMouseEvent *mouse) {
     active = true;
     QPoint pos = Metatile::coordFromPixmapCoord(mouse->scenePos());
@@ -2,48 +2,35 @@
 #include "encountertablemodel.h"
 
 #include <QSpinBox>
+#include <QAbstractItemView>
 #include "project.h"
 #include "noscrollcombobox.h"
 
 
 
-SpeciesComboDelegate::SpeciesComboDelegate(Project *project, QObject *parent) : QStyledItemDelegate(parent) {
+SpeciesComboDelegate::SpeciesComboDelegate(Project *project, QAbstractItemView *view) : QStyledItemDelegate(view) {
     this->project = project;
+
+    // Icons are loaded in the background, repaint the table when one is ready.
+    connect(project, &Project::speciesIconLoaded, view->viewport(), [view] {
+        view->viewport()->update();
+    });
 }
 
 void SpeciesComboDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
     QString species = index.data(Qt::DisplayRole).toString();
 
-    QPixmap pm;
-    if (!QPixmapCache::find(species, &pm)) {
-        // Prefer path from config. If not present, use the path parsed from project files
-        QString path = projectConfig.getPokemonIconPath(species);
-        if (path.isEmpty()) {
-            path = this->project->speciesToIconPath.value(species);
-        } else {
-            path = Project::getExistingFilepath(path);
-        }
-
-        QImage img(path);
-        if (img.isNull()) {
-            // No icon for this species, use placeholder
-            pm = QPixmap(":images/pokemon_icon_placeholder.png");
-        } else {
-            img.setColor(0, qRgba(0, 0, 0, 0));
-            pm = QPixmap::fromImage(img);
-        }
-        QPixmapCache::insert(species, pm);
-    }
-    QPixmap monIcon = pm.copy(0, 0, 32, 32);
-
     painter->drawText(QRect(option.rect.topLeft() + QPoint(36, 0), option.rect.bottomRight()), Qt::AlignLeft | Qt::AlignVCenter, species);
-    painter->drawPixmap(QRect(option.rect.topLeft(), QSize(32, 32)), monIcon, monIcon.rect());
+
+    const QPixmap monIcon = this->project->getSpeciesIcon(species);
+    if (!monIcon.isNull())
+        painter->drawPixmap(QRect(option.rect.topLeft(), QSize(32, 32)), monIcon, monIcon.rect());
 }
 
 QWidget *SpeciesComboDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &, const QModelIndex &) const {
     NoScrollComboBox *editor = new NoScrollComboBox(parent);
     editor->setFrame(false);
-    editor->addItems(this->project->speciesToIconPath.keys());
+    editor->setSharedModel(this->project->getListModel("species", this->project->getSpeciesIconPaths().keys()));
     return editor;
 }
 
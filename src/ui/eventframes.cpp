@@ -174,7 +174,9 @@ void EventFrame::populateScriptDropdown(NoScrollComboBox * combo, Project * proj
         combo->addItems(this->event->getMap()->getScriptLabels(this->event->getEventGroup()));
 
     // The dropdown's autocomplete has all script labels across the full project.
-    auto completer = new QCompleter(project->globalScriptLabels, combo);
+    ConstantListModel *scriptLabelsModel = project->getListModel("globalScriptLabels", project->globalScriptLabels);
+    auto completer = new QCompleter(scriptLabelsModel, combo);
+    scriptLabelsModel->addUser(completer);
     completer->setCaseSensitivity(Qt::CaseInsensitive);
     completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
     completer->setFilterMode(Qt::MatchContains);
@@ -379,10 +381,10 @@ void ObjectFrame::populate(Project *project) {
     const QSignalBlocker blocker(this);
     EventFrame::populate(project);
 
-    this->combo_sprite->addItems(project->gfxDefines.keys());
-    this->combo_movement->addItems(project->movementTypes);
-    this->combo_flag->addItems(project->flagNames);
-    this->combo_trainer_type->addItems(project->trainerTypes);
+    this->combo_sprite->setSharedModel(project->getListModel("gfx", project->gfxDefines.keys()));
+    this->combo_movement->setSharedModel(project->getListModel("movementTypes", project->movementTypes));
+    this->combo_flag->setSharedModel(project->getListModel("flagNames", project->flagNames));
+    this->combo_trainer_type->setSharedModel(project->getListModel("trainerTypes", project->trainerTypes));
 
     this->populateScriptDropdown(this->combo_script, project);
 }
@@ -472,7 +474,7 @@ void CloneObjectFrame::populate(Project *project) {
     const QSignalBlocker blocker(this);
     EventFrame::populate(project);
 
-    this->combo_target_map->addItems(project->mapNames);
+    this->combo_target_map->setSharedModel(project->getListModel("mapNames", project->mapNames));
 }
 
 void WarpFrame::setup() {
@@ -553,7 +555,7 @@ void WarpFrame::populate(Project *project) {
     const QSignalBlocker blocker(this);
     EventFrame::populate(project);
 
-    this->combo_dest_map->addItems(project->mapNames);
+    this->combo_dest_map->setSharedModel(project->getListModel("mapNames", project->mapNames));
 }
 
 
@@ -639,7 +641,7 @@ void TriggerFrame::populate(Project *project) {
     EventFrame::populate(project);
 
     // var combo
-    this->combo_var->addItems(project->varNames);
+    this->combo_var->setSharedModel(project->getListModel("varNames", project->varNames));
 
     this->populateScriptDropdown(this->combo_script, project);
 }
@@ -692,7 +694,7 @@ void WeatherTriggerFrame::populate(Project *project) {
     EventFrame::populate(project);
 
     // weather
-    this->combo_weather->addItems(project->coordEventWeatherNames);
+    this->combo_weather->setSharedModel(project->getListModel("coordEventWeatherNames", project->coordEventWeatherNames));
 }
 
 
@@ -761,7 +763,7 @@ void SignFrame::populate(Project *project) {
     EventFrame::populate(project);
 
     // facing dir
-    this->combo_facing_dir->addItems(project->bgEventFacingDirections);
+    this->combo_facing_dir->setSharedModel(project->getListModel("bgEventFacingDirections", project->bgEventFacingDirections));
 
     this->populateScriptDropdown(this->combo_script, project);
 }
@@ -876,8 +878,8 @@ void HiddenItemFrame::populate(Project *project) {
     const QSignalBlocker blocker(this);
     EventFrame::populate(project);
 
-    this->combo_item->addItems(project->itemNames);
-    this->combo_flag->addItems(project->flagNames);
+    this->combo_item->setSharedModel(project->getListModel("itemNames", project->itemNames));
+    this->combo_flag->setSharedModel(project->getListModel("flagNames", project->flagNames));
 }
 
 
@@ -930,7 +932,7 @@ void SecretBaseFrame::populate(Project *project) {
     const QSignalBlocker blocker(this);
     EventFrame::populate(project);
 
-    this->combo_base_id->addItems(project->secretBaseIds);
+    this->combo_base_id->setSharedModel(project->getListModel("secretBaseIds", project->secretBaseIds));
 }
 
 
@@ -1009,5 +1011,5 @@ void HealLocationFrame::populate(Project *project) {
     EventFrame::populate(project);
 
     if (projectConfig.getHealLocationRespawnDataEnabled())
-        this->combo_respawn_map->addItems(project->mapNames);
+        this->combo_respawn_map->setSharedModel(project->getListModel("mapNames", project->mapNames));
 }
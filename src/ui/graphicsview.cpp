@@ -2,6 +2,8 @@
 #include "mapview.h"
 #include "editor.h"
 
+#include <QtMath>
+
 void GraphicsView::mousePressEvent(QMouseEvent *event) {
     QGraphicsView::mousePressEvent(event);
     if (editor) {
@@ -24,23 +26,49 @@ void GraphicsView::moveEvent(QMoveEvent *event) {
         label_MapRulerStatus->move(mapToGlobal(QPoint(6, 6)));
 }
 
-void MapView::drawForeground(QPainter *painter, const QRectF&) {
+void MapView::drawForeground(QPainter *painter, const QRectF &rect) {
     foreach (Overlay * overlay, this->overlayMap)
-        overlay->renderItems(painter);
+        overlay->renderItems(painter, rect);
 
     if (!editor) return;
 
+    if (editor->map && editor->ui->checkBox_ToggleGrid->isChecked())
+        this->drawGrid(painter, rect);
+
     QStyleOptionGraphicsItem option;
-    for (QGraphicsLineItem* line : editor->gridLines) {
-        if (line && line->isVisible())
-            line->paint(painter, &option, this);
-    }
-    if (editor->playerViewRect && editor->playerViewRect->isVisible())
+    if (editor->playerViewRect && editor->playerViewRect->isVisible()
+     && editor->playerViewRect->sceneBoundingRect().intersects(rect))
         editor->playerViewRect->paint(painter, &option, this);
-    if (editor->cursorMapTileRect && editor->cursorMapTileRect->isVisible())
+    if (editor->cursorMapTileRect && editor->cursorMapTileRect->isVisible()
+     && editor->cursorMapTileRect->sceneBoundingRect().intersects(rect))
         editor->cursorMapTileRect->paint(painter, &option, this);
 }
 
+// Draws the lines of the metatile grid that are within the given rect.
+void MapView::drawGrid(QPainter *painter, const QRectF &rect) {
+    const int pixelWidth = editor->map->getWidth() * 16;
+    const int pixelHeight = editor->map->getHeight() * 16;
+    const QRectF area = rect.intersected(QRectF(0, 0, pixelWidth + 1, pixelHeight + 1));
+    if (area.isEmpty())
+        return;
+
+    const int left = qMax(qCeil(area.left() / 16), 0) * 16;
+    const int right = qMin(qFloor(area.right() / 16) * 16, pixelWidth);
+    const int top = qMax(qCeil(area.top() / 16), 0) * 16;
+    const int bottom = qMin(qFloor(area.bottom() / 16) * 16, pixelHeight);
+
+    QVector<QLineF> lines;
+    for (int x = left; x <= right; x += 16)
+        lines.append(QLineF(x, area.top(), x, qMin(area.bottom(), static_cast<qreal>(pixelHeight))));
+    for (int y = top; y <= bottom; y += 16)
+        lines.append(QLineF(area.left(), y, qMin(area.right(), static_cast<qreal>(pixelWidth)), y));
+
+    painter->save();
+    painter->setPen(QPen());
+    painter->drawLines(lines);
+    painter->restore();
+}
+
 void MapView::clearOverlayMap() {
     foreach (Overlay * overlay, this->overlayMap) {
         overlay->clearItems();
@@ -1,6 +1,7 @@
 #include "config.h"
 #include "imageproviders.h"
 #include "log.h"
+#include "profiling.h"
 #include "editor.h"
 #include <QPainter>
 
@@ -38,6 +39,7 @@ QImage getMetatileImage(
         QList<float> layerOpacity,
         bool useTruePalettes)
 {
+    PROFILE_SCOPE("getMetatileImage");
     QImage metatile_image(16, 16, QImage::Format_RGBA8888);
     if (!metatile) {
         metatile_image.fill(Qt::magenta);
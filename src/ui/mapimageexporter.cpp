@@ -2,6 +2,8 @@
 #include "ui_mapimageexporter.h"
 #include "qgifimage.h"
 #include "editcommands.h"
+#include "profiling.h"
+#include "log.h"
 
 #include <QFileDialog>
 #include <QImage>
@@ -71,109 +73,128 @@ void MapImageExporter::saveImage() {
     QString filepath = QFileDialog::getSaveFileName(this, title, defaultFilepath, filter);
     if (!filepath.isEmpty()) {
         editor->project->setImportExportPath(filepath);
-        switch (this->mode) {
-            case ImageExporterMode::Normal:
-                this->preview.save(filepath);
-                break;
+        if (this->writeImage(filepath))
+            this->close();
+    }
+}
+
+// Exports the image for the current mode to the given file. Returns false if the export was canceled or failed.
+bool MapImageExporter::writeImage(const QString &filepath) {
+    bool saved = false;
+    switch (this->mode) {
+        case ImageExporterMode::Normal: {
+            PROFILE_SCOPE("MapImageExporter::writeImage");
+            saved = this->preview.save(filepath);
+            break;
+        }
         case ImageExporterMode::Stitch: {
-                QProgressDialog progress("Building map stitch...", "Cancel", 0, 1, this);
-                progress.setAutoClose(true);
-                progress.setWindowModality(Qt::WindowModal);
-                progress.setModal(true);
-                QPixmap pixmap = this->getStitchedImage(&progress, this->showBorder);
-                if (progress.wasCanceled()) {
-                    progress.close();
-                    return;
-                }
-                pixmap.save(filepath);
+            QProgressDialog progress("Building map stitch...", "Cancel", 0, 1, this);
+            progress.setAutoClose(true);
+            progress.setWindowModality(Qt::WindowModal);
+            progress.setModal(true);
+            QPixmap pixmap = this->getStitchedImage(&progress, this->showBorder);
+            if (progress.wasCanceled()) {
                 progress.close();
-                break;
+                return false;
+            }
+            {
+                PROFILE_SCOPE("MapImageExporter::writeImage");
+                saved = pixmap.save(filepath);
+            }
+            progress.close();
+            break;
+        }
+        case ImageExporterMode::Timelapse:
+            QProgressDialog progress("Building map timelapse...", "Cancel", 0, 1, this);
+            progress.setAutoClose(true);
+            progress.setWindowModality(Qt::WindowModal);
+            progress.setModal(true);
+            progress.setMaximum(1);
+            progress.setValue(0);
+
+            int maxWidth = this->map->getWidth() * 16;
+            int maxHeight = this->map->getHeight() * 16;
+            if (showBorder) {
+                maxWidth += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
+                maxHeight += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
             }
-            case ImageExporterMode::Timelapse:
-                QProgressDialog progress("Building map timelapse...", "Cancel", 0, 1, this);
-                progress.setAutoClose(true);
-                progress.setWindowModality(Qt::WindowModal);
-                progress.setModal(true);
-                progress.setMaximum(1);
-                progress.setValue(0);
-
-                int maxWidth = this->map->getWidth() * 16;
-                int maxHeight = this->map->getHeight() * 16;
+            // Rewind to the specified start of the map edit history.
+            int i = 0;
+            while (this->map->editHistory.canUndo()) {
+                progress.setValue(i);
+                this->map->editHistory.undo();
+                int width = this->map->getWidth() * 16;
+                int height = this->map->getHeight() * 16;
                 if (showBorder) {
-                    maxWidth += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
-                    maxHeight += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
+                    width += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
+                    height += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
                 }
-                // Rewind to the specified start of the map edit history.
-                int i = 0;
-                while (this->map->editHistory.canUndo()) {
-                    progress.setValue(i);
-                    this->map->editHistory.undo();
-                    int width = this->map->getWidth() * 16;
-                    int height = this->map->getHeight() * 16;
-                    if (showBorder) {
-                        width += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
-                        height += 2 * STITCH_MODE_BORDER_DISTANCE * 16;
-                    }
-                    if (width > maxWidth) {
-                        maxWidth = width;
-                    }
-                    if (height > maxHeight) {
-                        maxHeight = height;
-                    }
-                    i++;
+                if (width > maxWidth) {
+                    maxWidth = width;
                 }
-                QGifImage timelapseImg(QSize(maxWidth, maxHeight));
-                timelapseImg.setDefaultDelay(timelapseDelayMs);
-                timelapseImg.setDefaultTransparentColor(QColor(0, 0, 0));
-                // Draw each frame, skpping the specified number of map edits in
-                // the undo history.
-                progress.setMaximum(i);
-                while (i > 0) {
-                    if (progress.wasCanceled()) {
-                        progress.close();
-                        while (i > 0 && this->map->editHistory.canRedo()) {
-                            i--;
-                            this->map->editHistory.redo();
-                        }
-                        return;
-                    }
-                    while (this->map->editHistory.canRedo() &&
-                           !historyItemAppliesToFrame(this->map->editHistory.command(this->map->editHistory.index()))) {
+                if (height > maxHeight) {
+                    maxHeight = height;
+                }
+                i++;
+            }
+            QGifImage timelapseImg(QSize(maxWidth, maxHeight));
+            timelapseImg.setDefaultDelay(timelapseDelayMs);
+            timelapseImg.setDefaultTransparentColor(QColor(0, 0, 0));
+            // Draw each frame, skpping the specified number of map edits in
+            // the undo history.
+            progress.setMaximum(i);
+            while (i > 0) {
+                if (progress.wasCanceled()) {
+                    progress.close();
+                    while (i > 0 && this->map->editHistory.canRedo()) {
                         i--;
                         this->map->editHistory.redo();
                     }
-                    progress.setValue(progress.maximum() - i);
-                    QPixmap pixmap = this->getFormattedMapPixmap(this->map, !this->showBorder);
-                    if (pixmap.width() < maxWidth || pixmap.height() < maxHeight) {
-                        QPixmap pixmap2 = QPixmap(maxWidth, maxHeight);
-                        QPainter painter(&pixmap2);
-                        pixmap2.fill(QColor(0, 0, 0));
-                        painter.drawPixmap(0, 0, pixmap.width(), pixmap.height(), pixmap);
-                        painter.end();
-                        pixmap = pixmap2;
-                    }
-                    timelapseImg.addFrame(pixmap.toImage());
-                    for (int j = 0; j < timelapseSkipAmount; j++) {
-                        if (i > 0) {
+                    return false;
+                }
+                while (this->map->editHistory.canRedo() &&
+                       !historyItemAppliesToFrame(this->map->editHistory.command(this->map->editHistory.index()))) {
+                    i--;
+                    this->map->editHistory.redo();
+                }
+                progress.setValue(progress.maximum() - i);
+                QPixmap pixmap = this->getFormattedMapPixmap(this->map, !this->showBorder);
+                if (pixmap.width() < maxWidth || pixmap.height() < maxHeight) {
+                    QPixmap pixmap2 = QPixmap(maxWidth, maxHeight);
+                    QPainter painter(&pixmap2);
+                    pixmap2.fill(QColor(0, 0, 0));
+                    painter.drawPixmap(0, 0, pixmap.width(), pixmap.height(), pixmap);
+                    painter.end();
+                    pixmap = pixmap2;
+                }
+                timelapseImg.addFrame(pixmap.toImage());
+                for (int j = 0; j < timelapseSkipAmount; j++) {
+                    if (i > 0) {
+                        i--;
+                        this->map->editHistory.redo();
+                        while (this->map->editHistory.canRedo() &&
+                               !historyItemAppliesToFrame(this->map->editHistory.command(this->map->editHistory.index()))) {
                             i--;
                             this->map->editHistory.redo();
-                            while (this->map->editHistory.canRedo() &&
-                                   !historyItemAppliesToFrame(this->map->editHistory.command(this->map->editHistory.index()))) {
-                                i--;
-                                this->map->editHistory.redo();
-                            }
                         }
                     }
                 }
-                // The latest map state is the last animated frame.
-                QPixmap pixmap = this->getFormattedMapPixmap(this->map, !this->showBorder);
-                timelapseImg.addFrame(pixmap.toImage());
-                timelapseImg.save(filepath);
-                progress.close();
-                break;
-        }
-        this->close();
+            }
+            // The latest map state is the last animated frame.
+            QPixmap pixmap = this->getFormattedMapPixmap(this->map, !this->showBorder);
+            timelapseImg.addFrame(pixmap.toImage());
+            {
+                PROFILE_SCOPE("MapImageExporter::writeTimelapse");
+                saved = timelapseImg.save(filepath);
+            }
+            progress.close();
+            break;
+    }
+    if (!saved) {
+        logError(QString("Failed to write map image to '%1'").arg(filepath));
+        return false;
     }
+    return true;
 }
 
 bool MapImageExporter::historyItemAppliesToFrame(const QUndoCommand *command) {
@@ -216,6 +237,7 @@ struct StitchedMap {
 };
 
 QPixmap MapImageExporter::getStitchedImage(QProgressDialog *progress, bool includeBorder) {
+    PROFILE_SCOPE("MapImageExporter::getStitchedImage");
     // Do a breadth-first search to gather a collection of
     // all reachable maps with their relative offsets.
     QSet<QString> visited;
@@ -355,6 +377,7 @@ void MapImageExporter::updatePreview() {
 }
 
 QPixmap MapImageExporter::getFormattedMapPixmap(Map *map, bool ignoreBorder) {
+    PROFILE_SCOPE("MapImageExporter::getFormattedMapPixmap");
     QPixmap pixmap;
 
     // draw background layer / base image
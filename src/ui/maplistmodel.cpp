@@ -0,0 +1,371 @@
+#include "maplistmodel.h"
+#include "project.h"
+
+#include <QRegularExpression>
+
+static quint64 getTrigramKey(const QString &text, int i) {
+    return (static_cast<quint64>(text.at(i).unicode()) << 32)
+         | (static_cast<quint64>(text.at(i + 1).unicode()) << 16)
+         |  static_cast<quint64>(text.at(i + 2).unicode());
+}
+
+// Filters that use regular expression syntax can't be searched for in the index.
+static bool isRegexFilter(const QString &filter) {
+    static const QRegularExpression re_regexSyntax("[\\\\^$.|?*+()\\[\\]{}]");
+    return filter.contains(re_regexSyntax);
+}
+
+MapListModel::MapListModel(QObject *parent) : QAbstractItemModel(parent) {
+    this->mapIcon = QIcon(QStringLiteral(":/icons/map.ico"));
+    this->mapEditedIcon = QIcon(QStringLiteral(":/icons/map_edited.ico"));
+    this->mapOpenedIcon = QIcon(QStringLiteral(":/icons/map_opened.ico"));
+
+    this->mapFolderIcon.addFile(QStringLiteral(":/icons/folder_closed_map.ico"), QSize(), QIcon::Normal, QIcon::Off);
+    this->mapFolderIcon.addFile(QStringLiteral(":/icons/folder_map.ico"), QSize(), QIcon::Normal, QIcon::On);
+
+    this->folderIcon.addFile(QStringLiteral(":/icons/folder_closed.ico"), QSize(), QIcon::Normal, QIcon::Off);
+}
+
+// Reads the list of maps from the project. This should be called again if maps are added.
+void MapListModel::setProject(Project *project) {
+    beginResetModel();
+    this->project = project;
+    this->readMaps();
+    this->buildFolders();
+    this->applyFilter();
+    endResetModel();
+}
+
+// Regroups the maps into folders for the given sort order.
+// This also picks up changes to the maps' areas and layouts.
+void MapListModel::setSortOrder(MapSortOrder sortOrder) {
+    beginResetModel();
+    this->sortOrder = sortOrder;
+    this->buildFolders();
+    this->applyFilter();
+    endResetModel();
+}
+
+void MapListModel::readMaps() {
+    this->maps.clear();
+    this->mapIds.clear();
+    this->trigramIndex.clear();
+    if (!this->project)
+        return;
+
+    for (int i = 0; i < this->project->groupNames.length(); i++) {
+        const QStringList names = this->project->groupedMapNames.value(i);
+        for (int j = 0; j < names.length(); j++) {
+            MapEntry entry;
+            entry.name = names.at(j);
+            entry.text = QString("[%1.%2] ").arg(i).arg(j, 2, 10, QLatin1Char('0')) + entry.name;
+            entry.filterText = entry.text.toLower();
+            entry.group = i;
+
+            const int id = this->maps.length();
+            for (int k = 0; k + 3 <= entry.filterText.length(); k++) {
+                QVector<int> &ids = this->trigramIndex[getTrigramKey(entry.filterText, k)];
+                if (ids.isEmpty() || ids.last() != id)
+                    ids.append(id);
+            }
+            this->mapIds.insert(entry.name, id);
+            this->maps.append(entry);
+        }
+    }
+}
+
+void MapListModel::buildFolders() {
+    this->folders.clear();
+    for (MapEntry &entry : this->maps) {
+        entry.folder = -1;
+        entry.row = -1;
+    }
+    if (!this->project)
+        return;
+
+    // Determine each map's folder. Maps with an unknown area or layout are put in the first folder.
+    QVector<int> mapFolders(this->maps.length(), 0);
+    switch (this->sortOrder)
+    {
+    case MapSortOrder::Group:
+        for (int i = 0; i < this->project->groupNames.length(); i++) {
+            Folder folder;
+            folder.name = this->project->groupNames.at(i);
+            folder.type = "map_group";
+            folder.groupNum = i;
+            this->folders.append(folder);
+        }
+        for (int id = 0; id < this->maps.length(); id++)
+            mapFolders[id] = this->maps.at(id).group;
+        break;
+    case MapSortOrder::Area:
+    {
+        QMap<QString, int> mapsecToFolder;
+        for (int i = 0; i < this->project->mapSectionNameToValue.size(); i++) {
+            Folder folder;
+            folder.name = this->project->mapSectionValueToName.value(i);
+            folder.type = "map_sec";
+            folder.groupNum = i;
+            this->folders.append(folder);
+            mapsecToFolder.insert(folder.name, i);
+        }
+        for (int id = 0; id < this->maps.length(); id++)
+            mapFolders[id] = mapsecToFolder.value(this->project->readMapLocation(this->maps.at(id).name));
+        break;
+    }
+    case MapSortOrder::Layout:
+    {
+        QMap<QString, int> layoutToFolder;
+        for (int i = 0; i < this->project->mapLayoutsTable.length(); i++) {
+            const QString layoutId = this->project->mapLayoutsTable.at(i);
+            MapLayout *layout = this->project->mapLayouts.value(layoutId);
+            Folder folder;
+            folder.name = layout ? layout->name : layoutId;
+            folder.type = "map_layout";
+            folder.layoutId = layoutId;
+            folder.groupNum = i;
+            this->folders.append(folder);
+            layoutToFolder.insert(layoutId, i);
+        }
+        for (int id = 0; id < this->maps.length(); id++)
+            mapFolders[id] = layoutToFolder.value(this->project->readMapLayoutId(this->maps.at(id).name));
+        break;
+    }
+    }
+
+    for (int id = 0; id < this->maps.length(); id++) {
+        const int folderIndex = mapFolders.at(id);
+        if (folderIndex < 0 || folderIndex >= this->folders.length())
+            continue;
+        MapEntry &entry = this->maps[id];
+        entry.folder = folderIndex;
+        entry.row = this->folders.at(folderIndex).maps.length();
+        this->folders[folderIndex].maps.append(id);
+    }
+}
+
+// Filters are case-insensitive. Maps match if their text or their folder's name contains the filter,
+// and folders match if their name or any of their maps' text contains the filter.
+void MapListModel::setFilter(const QString &filter) {
+    this->filter = filter;
+    this->applyFilter();
+}
+
+void MapListModel::applyFilter() {
+    this->mapMatches.fill(false, this->maps.length());
+    this->folderMatches.fill(false, this->folders.length());
+    this->folderAccepted.fill(false, this->folders.length());
+    if (this->filter.isEmpty())
+        return;
+
+    if (isRegexFilter(this->filter)) {
+        const QRegularExpression re(this->filter, QRegularExpression::CaseInsensitiveOption);
+        for (int id = 0; id < this->maps.length(); id++)
+            this->mapMatches[id] = this->maps.at(id).text.contains(re);
+        for (int i = 0; i < this->folders.length(); i++)
+            this->folderMatches[i] = this->folders.at(i).name.contains(re);
+    } else {
+        const QString text = this->filter.toLower();
+        for (int id : this->findMaps(text))
+            this->mapMatches[id] = true;
+        for (int i = 0; i < this->folders.length(); i++)
+            this->folderMatches[i] = this->folders.at(i).name.contains(text, Qt::CaseInsensitive);
+    }
+
+    for (int i = 0; i < this->folders.length(); i++) {
+        bool accepted = this->folderMatches.at(i);
+        for (int j = 0; !accepted && j < this->folders.at(i).maps.length(); j++)
+            accepted = this->mapMatches.at(this->folders.at(i).maps.at(j));
+        this->folderAccepted[i] = accepted;
+    }
+}
+
+// Returns the maps whose (lowercase) text contains the given lowercase text.
+QVector<int> MapListModel::findMaps(const QString &text) const {
+    QVector<int> ids;
+    if (text.length() < 3) {
+        for (int id = 0; id < this->maps.length(); id++) {
+            if (this->maps.at(id).filterText.contains(text))
+                ids.append(id);
+        }
+        return ids;
+    }
+
+    // A map can only contain the text if it contains each of the text's trigrams,
+    // so only the maps with the text's least common trigram need to be checked.
+    const QVector<int> *candidates = nullptr;
+    for (int i = 0; i + 3 <= text.length(); i++) {
+        auto it = this->trigramIndex.constFind(getTrigramKey(text, i));
+        if (it == this->trigramIndex.constEnd())
+            return ids;
+        if (!candidates || it.value().length() < candidates->length())
+            candidates = &it.value();
+    }
+    for (int id : *candidates) {
+        if (this->maps.at(id).filterText.contains(text))
+            ids.append(id);
+    }
+    return ids;
+}
+
+bool MapListModel::filterAccepts(int row, const QModelIndex &parent) const {
+    if (this->filter.isEmpty())
+        return true;
+    if (!parent.isValid())
+        return this->folderAccepted.value(row, false);
+
+    const int folderIndex = parent.row();
+    if (this->folderMatches.value(folderIndex, false))
+        return true;
+    const int id = this->folders.value(folderIndex).maps.value(row, -1);
+    return this->mapMatches.value(id, false);
+}
+
+void MapListModel::setOpenMap(const QString &mapName) {
+    if (this->openMapName == mapName)
+        return;
+    const QModelIndex oldIndex = this->indexOfMap(this->openMapName);
+    this->openMapName = mapName;
+    if (oldIndex.isValid())
+        emit dataChanged(oldIndex, oldIndex, {Qt::DecorationRole});
+    const QModelIndex newIndex = this->indexOfMap(mapName);
+    if (newIndex.isValid())
+        emit dataChanged(newIndex, newIndex, {Qt::DecorationRole});
+}
+
+// Only maps that have been loaded can have changes, so only their rows need to be updated.
+void MapListModel::updateMapIcons() {
+    if (!this->project)
+        return;
+    for (auto it = this->project->mapCache.constBegin(); it != this->project->mapCache.constEnd(); it++) {
+        const QModelIndex index = this->indexOfMap(it.key());
+        if (index.isValid())
+            emit dataChanged(index, index, {Qt::DecorationRole});
+    }
+}
+
+QIcon MapListModel::getMapIcon(const QString &mapName) const {
+    if (mapName == this->openMapName)
+        return this->mapOpenedIcon;
+    if (this->project) {
+        Map *map = this->project->mapCache.value(mapName);
+        if (map && map->hasUnsavedChanges())
+            return this->mapEditedIcon;
+    }
+    return this->mapIcon;
+}
+
+QModelIndex MapListModel::indexOfMap(const QString &mapName) const {
+    auto it = this->mapIds.constFind(mapName);
+    if (it == this->mapIds.constEnd())
+        return QModelIndex();
+    const MapEntry &entry = this->maps.at(it.value());
+    if (entry.folder < 0)
+        return QModelIndex();
+    return createIndex(entry.row, 0, static_cast<quintptr>(entry.folder + 1));
+}
+
+// Returns the maps directly above and below the given map in its folder.
+QStringList MapListModel::getAdjacentMaps(const QString &mapName) const {
+    QStringList adjacentMaps;
+    auto it = this->mapIds.constFind(mapName);
+    if (it == this->mapIds.constEnd())
+        return adjacentMaps;
+    const MapEntry &entry = this->maps.at(it.value());
+    if (entry.folder < 0)
+        return adjacentMaps;
+
+    const QVector<int> &folderMaps = this->folders.at(entry.folder).maps;
+    if (entry.row > 0)
+        adjacentMaps.append(this->maps.at(folderMaps.at(entry.row - 1)).name);
+    if (entry.row + 1 < folderMaps.length())
+        adjacentMaps.append(this->maps.at(folderMaps.at(entry.row + 1)).name);
+    return adjacentMaps;
+}
+
+// Folders are top-level rows with an internal id of 0. Maps have the internal id of their folder's row + 1.
+QModelIndex MapListModel::index(int row, int column, const QModelIndex &parent) const {
+    if (row < 0 || column != 0)
+        return QModelIndex();
+    if (!parent.isValid()) {
+        if (row >= this->folders.length())
+            return QModelIndex();
+        return createIndex(row, 0, static_cast<quintptr>(0));
+    }
+    if (parent.internalId() != 0 || row >= this->folders.at(parent.row()).maps.length())
+        return QModelIndex();
+    return createIndex(row, 0, static_cast<quintptr>(parent.row() + 1));
+}
+
+QModelIndex MapListModel::parent(const QModelIndex &child) const {
+    if (!child.isValid() || child.internalId() == 0)
+        return QModelIndex();
+    return createIndex(static_cast<int>(child.internalId() - 1), 0, static_cast<quintptr>(0));
+}
+
+int MapListModel::rowCount(const QModelIndex &parent) const {
+    if (!parent.isValid())
+        return this->folders.length();
+    if (parent.internalId() != 0 || parent.column() != 0)
+        return 0;
+    return this->folders.at(parent.row()).maps.length();
+}
+
+int MapListModel::columnCount(const QModelIndex &) const {
+    return 1;
+}
+
+QVariant MapListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid())
+        return QVariant();
+
+    if (index.internalId() == 0) {
+        const Folder &folder = this->folders.at(index.row());
+        switch (role)
+        {
+        case Qt::DisplayRole:
+        case Qt::UserRole:
+            return folder.name;
+        case Qt::DecorationRole:
+            return (folder.type == "map_group" || !folder.maps.isEmpty()) ? this->mapFolderIcon : this->folderIcon;
+        case MapListUserRoles::TypeRole:
+            return folder.type;
+        case MapListUserRoles::TypeRole2:
+            return folder.layoutId.isEmpty() ? QVariant() : folder.layoutId;
+        case MapListUserRoles::GroupRole:
+            return folder.groupNum;
+        }
+        return QVariant();
+    }
+
+    const Folder &folder = this->folders.at(static_cast<int>(index.internalId() - 1));
+    const MapEntry &entry = this->maps.at(folder.maps.at(index.row()));
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return entry.text;
+    case Qt::DecorationRole:
+        return this->getMapIcon(entry.name);
+    case Qt::UserRole:
+        return entry.name;
+    case MapListUserRoles::TypeRole:
+        return "map_name";
+    }
+    return QVariant();
+}
+
+
+
+MapListProxyModel::MapListProxyModel(MapListModel *model, QObject *parent) : QSortFilterProxyModel(parent) {
+    this->model = model;
+    this->setSourceModel(model);
+}
+
+void MapListProxyModel::setFilterText(const QString &text) {
+    this->model->setFilter(text);
+    this->invalidateFilter();
+}
+
+bool MapListProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    return this->model->filterAccepts(sourceRow, sourceParent);
+}
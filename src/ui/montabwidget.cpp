@@ -12,6 +12,7 @@ MonTabWidget::MonTabWidget(Editor *editor, QWidget *parent) : QTabWidget(parent)
     this->editor = editor;
     populate();
     this->tabBar()->installEventFilter(this);
+    connect(this, &QTabWidget::currentChanged, this, &MonTabWidget::populateTabOnDemand);
 }
 
 MonTabWidget::~MonTabWidget() {
@@ -29,6 +30,8 @@ void MonTabWidget::populate() {
     EncounterFields fields = editor->project->wildMonFields;
     activeTabs.resize(fields.size());
     activeTabs.fill(false);
+    populatedTabs.resize(fields.size());
+    populatedTabs.fill(false);
 
     addDeleteTabButtons.resize(fields.size());
     addDeleteTabButtons.fill(nullptr);
@@ -40,6 +43,10 @@ void MonTabWidget::populate() {
         QTableView *table = new QTableView(this);
         table->setEditTriggers(QAbstractItemView::AllEditTriggers);
         table->clearFocus();
+        table->setItemDelegateForColumn(EncounterTableModel::ColumnType::Species, new SpeciesComboDelegate(editor->project, table));
+        table->setItemDelegateForColumn(EncounterTableModel::ColumnType::MinLevel, new SpinBoxDelegate(editor->project, table));
+        table->setItemDelegateForColumn(EncounterTableModel::ColumnType::MaxLevel, new SpinBoxDelegate(editor->project, table));
+        table->setItemDelegateForColumn(EncounterTableModel::ColumnType::EncounterRate, new SpinBoxDelegate(editor->project, table));
         addTab(table, field.name);
 
         QPushButton *buttonAddDelete = new QPushButton(QIcon(":/icons/add.ico"), "");
@@ -56,9 +63,77 @@ void MonTabWidget::populate() {
     }
 }
 
+// Displays the encounters of the given map and group label. The tables are filled in once they're first displayed,
+// until then their encounters are read from the project.
+void MonTabWidget::load(const QString &mapConstant, const QString &groupLabel) {
+    this->mapConstant = mapConstant;
+    this->groupLabel = groupLabel;
+
+    this->loading = true;
+    for (int i = 0; i < this->count(); i++) {
+        setTableModel(i, nullptr);
+        clearTableAt(i);
+        setTabActive(i, projectEncounterData(i).active);
+    }
+    this->loading = false;
+
+    if (this->isVisible())
+        populateTabOnDemand(this->currentIndex());
+}
+
+// Tab widgets can be reused as long as the encounter fields they were created for haven't changed.
+bool MonTabWidget::hasFields(const EncounterFields &fields) {
+    if (this->count() != fields.size())
+        return false;
+    for (int i = 0; i < fields.size(); i++) {
+        if (this->tabText(i) != fields.at(i).name)
+            return false;
+    }
+    return true;
+}
+
+void MonTabWidget::showEvent(QShowEvent *event) {
+    QTabWidget::showEvent(event);
+    populateTabOnDemand(this->currentIndex());
+}
+
+void MonTabWidget::populateTabOnDemand(int tabIndex) {
+    if (this->loading || tabIndex < 0 || tabIndex >= this->count())
+        return;
+    if (this->activeTabs[tabIndex] && !this->populatedTabs[tabIndex])
+        populateTab(tabIndex, projectEncounterData(tabIndex));
+}
+
+WildMonInfo MonTabWidget::projectEncounterData(int tabIndex) {
+    const auto &wildMonData = editor->project->wildMonData;
+    const QString fieldName = editor->project->wildMonFields.value(tabIndex).name;
+    if (!wildMonData.count(this->mapConstant))
+        return WildMonInfo();
+    const auto &encounterMap = wildMonData.at(this->mapConstant);
+    if (!encounterMap.count(this->groupLabel))
+        return WildMonInfo();
+    const auto &wildMons = encounterMap.at(this->groupLabel).wildMons;
+    if (!wildMons.count(fieldName))
+        return WildMonInfo();
+    return wildMons.at(fieldName);
+}
+
+bool MonTabWidget::isTabPopulated(int tabIndex) {
+    return this->populatedTabs.value(tabIndex, false);
+}
+
+// Returns the encounters displayed in the given tab, or those in the project if the tab hasn't been displayed yet.
+WildMonInfo MonTabWidget::encounterData(int tabIndex) {
+    if (isTabPopulated(tabIndex)) {
+        EncounterTableModel *model = static_cast<EncounterTableModel *>(this->tableAt(tabIndex)->model());
+        if (model)
+            return model->encounterData();
+    }
+    return projectEncounterData(tabIndex);
+}
+
 void MonTabWidget::copy(int index) {
-    EncounterTableModel *model = static_cast<EncounterTableModel *>(this->tableAt(index)->model());
-    encounterClipboard = model->encounterData();
+    encounterClipboard = encounterData(index);
 }
 
 void MonTabWidget::paste(int index) {
@@ -114,28 +189,31 @@ void MonTabWidget::clearTableAt(int tabIndex) {
 }
 
 void MonTabWidget::deactivateTab(int tabIndex) {
-    QTableView *speciesTable = tableAt(tabIndex);
-
-    EncounterTableModel *oldModel = static_cast<EncounterTableModel *>(speciesTable->model());
-    WildMonInfo monInfo = oldModel->encounterData();
+    WildMonInfo monInfo = encounterData(tabIndex);
     monInfo.active = false;
-    EncounterTableModel *newModel = new EncounterTableModel(monInfo, editor->project->wildMonFields, tabIndex, this);
-    speciesTable->setModel(newModel);
+    setTableModel(tabIndex, new EncounterTableModel(monInfo, editor->project->wildMonFields, tabIndex, this));
+    this->populatedTabs[tabIndex] = true;
 
     setTabActive(tabIndex, false);
 }
 
+// Replaces the model of the table in the given tab, deleting the previous one.
+void MonTabWidget::setTableModel(int tabIndex, QAbstractItemModel *model) {
+    QTableView *table = tableAt(tabIndex);
+    QAbstractItemModel *oldModel = table->model();
+    table->setModel(model);
+    if (oldModel)
+        oldModel->deleteLater();
+    this->populatedTabs[tabIndex] = false;
+}
+
 void MonTabWidget::populateTab(int tabIndex, WildMonInfo monInfo) {
     QTableView *speciesTable = tableAt(tabIndex);
 
     EncounterTableModel *model = new EncounterTableModel(monInfo, editor->project->wildMonFields, tabIndex, this);
     connect(model, &EncounterTableModel::edited, editor, &Editor::saveEncounterTabData);
-    speciesTable->setModel(model);
-
-    speciesTable->setItemDelegateForColumn(EncounterTableModel::ColumnType::Species, new SpeciesComboDelegate(editor->project, this));
-    speciesTable->setItemDelegateForColumn(EncounterTableModel::ColumnType::MinLevel, new SpinBoxDelegate(editor->project, this));
-    speciesTable->setItemDelegateForColumn(EncounterTableModel::ColumnType::MaxLevel, new SpinBoxDelegate(editor->project, this));
-    speciesTable->setItemDelegateForColumn(EncounterTableModel::ColumnType::EncounterRate, new SpinBoxDelegate(editor->project, this));
+    setTableModel(tabIndex, model);
+    this->populatedTabs[tabIndex] = true;
 
     speciesTable->horizontalHeader()->setSectionResizeMode(EncounterTableModel::ColumnType::Slot, QHeaderView::ResizeToContents);
     speciesTable->horizontalHeader()->setSectionResizeMode(EncounterTableModel::ColumnType::Group, QHeaderView::ResizeToContents);
@@ -149,9 +227,7 @@ void MonTabWidget::populateTab(int tabIndex, WildMonInfo monInfo) {
     // give enough vertical space for icons + margins
     speciesTable->verticalHeader()->setMinimumSectionSize(40);
 
-    if (editor->project->wildMonFields[tabIndex].groups.empty()) {
-        speciesTable->setColumnHidden(1, true);
-    }
+    speciesTable->setColumnHidden(EncounterTableModel::ColumnType::Group, editor->project->wildMonFields[tabIndex].groups.empty());
 
     speciesTable->horizontalHeader()->show();
     this->setTabActive(tabIndex, true);
@@ -28,12 +28,12 @@ NewMapPopup::~NewMapPopup()
 
 void NewMapPopup::init() {
     // Populate combo boxes
-    ui->comboBox_NewMap_Primary_Tileset->addItems(project->primaryTilesetLabels);
-    ui->comboBox_NewMap_Secondary_Tileset->addItems(project->secondaryTilesetLabels);
+    ui->comboBox_NewMap_Primary_Tileset->setSharedModel(project->getListModel("primaryTilesetLabels", project->primaryTilesetLabels));
+    ui->comboBox_NewMap_Secondary_Tileset->setSharedModel(project->getListModel("secondaryTilesetLabels", project->secondaryTilesetLabels));
     ui->comboBox_NewMap_Group->addItems(project->groupNames);
-    ui->comboBox_NewMap_Song->addItems(project->songNames);
-    ui->comboBox_NewMap_Type->addItems(project->mapTypes);
-    ui->comboBox_NewMap_Location->addItems(project->mapSectionNameToValue.keys());
+    ui->comboBox_NewMap_Song->setSharedModel(project->getListModel("songNames", project->songNames));
+    ui->comboBox_NewMap_Type->setSharedModel(project->getListModel("mapTypes", project->mapTypes));
+    ui->comboBox_NewMap_Location->setSharedModel(project->getListModel("mapSectionNames", project->mapSectionNameToValue.keys()));
 
     // Set spin box limits
     ui->spinBox_NewMap_Width->setMinimum(1);
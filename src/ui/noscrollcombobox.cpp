@@ -1,6 +1,8 @@
 #include "noscrollcombobox.h"
+#include "constantlistmodel.h"
 
 #include <QCompleter>
+#include <QListView>
 
 NoScrollComboBox::NoScrollComboBox(QWidget *parent)
     : QComboBox(parent)
@@ -61,3 +63,23 @@ void NoScrollComboBox::setHexItem(uint32_t value)
 {
     this->setItem(this->findData(value), "0x" + QString::number(value, 16).toUpper());
 }
+
+// Lists the items of a model owned elsewhere, which may be shared with other combo boxes.
+// Text entered that isn't in the model won't be added to it.
+void NoScrollComboBox::setSharedModel(QAbstractItemModel *model)
+{
+    this->setInsertPolicy(QComboBox::NoInsert);
+    auto oldModel = qobject_cast<ConstantListModel *>(this->model());
+    this->setModel(model);
+
+    // Let the project know which of its shared models are still in use.
+    auto constantModel = qobject_cast<ConstantListModel *>(model);
+    if (constantModel) constantModel->addUser(this);
+    if (oldModel && oldModel != constantModel) oldModel->removeUser(this);
+
+    // Shared models can be very long (e.g. flags or vars), improve display speed for the dropdown and autocomplete popup.
+    auto view = qobject_cast<QListView *>(this->view());
+    if (view) view->setUniformItemSizes(true);
+    auto popup = this->completer() ? qobject_cast<QListView *>(this->completer()->popup()) : nullptr;
+    if (popup) popup->setUniformItemSizes(true);
+}
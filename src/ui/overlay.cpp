@@ -2,6 +2,9 @@
 #include "scripting.h"
 #include "log.h"
 
+#include <QtMath>
+#include <algorithm>
+
 void OverlayText::render(QPainter *painter) {
     QFont font = painter->font();
     font.setPixelSize(this->fontSize);
@@ -20,8 +23,57 @@ void OverlayImage::render(QPainter *painter) {
     painter->drawImage(this->x, this->y, this->image);
 }
 
-void Overlay::renderItems(QPainter *painter) {
-    if (this->hidden) return;
+// Size (in pixels) of the cells used to index overlay items
+static const int itemIndexCellSize = 256;
+// Items that cover more cells than this are checked individually instead of being indexed
+static const int maxIndexedCells = 64;
+// Overlays with fewer items than this are cheap enough to render directly
+static const int minCachedItems = 32;
+// Largest width/height of a cached overlay image
+static const int maxCacheSize = 4096;
+
+static QRect getIndexCells(const QRectF &rect) {
+    return QRect(QPoint(qFloor(rect.left() / itemIndexCellSize), qFloor(rect.top() / itemIndexCellSize)),
+                 QPoint(qFloor(rect.right() / itemIndexCellSize), qFloor(rect.bottom() / itemIndexCellSize)));
+}
+
+static quint64 getIndexKey(int x, int y) {
+    return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
+void Overlay::renderItems(QPainter *painter, const QRectF &exposedRect) {
+    if (this->hidden || this->items.isEmpty()) return;
+
+    QRectF visibleRect = exposedRect;
+    if (this->clippingRect) {
+        visibleRect = visibleRect.intersected(*this->clippingRect);
+        if (visibleRect.isEmpty()) return;
+    }
+
+    QTransform itemTransform;
+    itemTransform.translate(this->x, this->y);
+    itemTransform.rotate(this->angle);
+    itemTransform.scale(this->hScale, this->vScale);
+
+    // Find the exposed area in the overlay's coordinates.
+    bool invertible;
+    const QTransform inverted = itemTransform.inverted(&invertible);
+    if (!invertible) return;
+    const QRectF itemRect = inverted.mapRect(visibleRect);
+
+    // Text items need to be measured again if they'll be drawn with a different font.
+    if (painter->font() != this->font) {
+        this->font = painter->font();
+        for (auto item : this->items)
+            item->setFont(this->font);
+        this->invalidateItems();
+    }
+    if (!this->itemIndexValid)
+        this->buildItemIndex();
+    if (!itemRect.intersects(this->allItemsBounds)) {
+        this->unchangedRenders++;
+        return;
+    }
 
     painter->save();
 
@@ -30,17 +82,112 @@ void Overlay::renderItems(QPainter *painter) {
         painter->setClipRect(*this->clippingRect);
     }
 
-    QTransform transform = painter->transform();
-    transform.translate(this->x, this->y);
-    transform.rotate(this->angle);
-    transform.scale(this->hScale, this->vScale);
+    const QTransform transform = itemTransform * painter->transform();
     painter->setTransform(transform);
 
-    painter->setOpacity(this->opacity);
-    for (auto item : this->items)
-        item->render(painter);
+    // Cache the rendered items once they've gone unchanged for a repaint, at the resolution they're displayed.
+    if (this->items.length() >= minCachedItems && this->unchangedRenders > 0) {
+        const qreal scale = qMax(qSqrt(transform.m11() * transform.m11() + transform.m12() * transform.m12()),
+                                 qSqrt(transform.m21() * transform.m21() + transform.m22() * transform.m22()));
+        if (!this->cacheValid || this->cacheScale != scale)
+            this->renderCache(painter, scale);
+    }
+
+    if (this->cacheValid && !this->cache.isNull()) {
+        painter->drawPixmap(this->allItemsBounds, this->cache, QRectF(this->cache.rect()));
+    } else {
+        painter->setOpacity(this->opacity);
+        for (int i : this->getItemsInRect(itemRect))
+            this->items.at(i)->render(painter);
+    }
 
     painter->restore();
+    this->unchangedRenders++;
+}
+
+void Overlay::renderCache(QPainter *painter, qreal scale) {
+    this->cacheValid = true;
+    this->cacheScale = scale;
+    this->cache = QPixmap();
+
+    const QSize size = (this->allItemsBounds.size() * scale).toSize();
+    if (size.isEmpty() || size.width() > maxCacheSize || size.height() > maxCacheSize)
+        return;
+
+    this->cache = QPixmap(size);
+    this->cache.fill(Qt::transparent);
+
+    // Rendering each item with the overlay's opacity gives the same result as painting them directly.
+    QPainter cachePainter(&this->cache);
+    cachePainter.setRenderHints(painter->renderHints());
+    cachePainter.setFont(painter->font());
+    cachePainter.setOpacity(this->opacity);
+    cachePainter.scale(scale, scale);
+    cachePainter.translate(-this->allItemsBounds.topLeft());
+    for (auto item : this->items)
+        item->render(&cachePainter);
+}
+
+void Overlay::buildItemIndex() {
+    this->itemBounds.clear();
+    this->itemIndex.clear();
+    this->unindexedItems.clear();
+    this->allItemsBounds = QRectF();
+
+    for (int i = 0; i < this->items.length(); i++) {
+        const QRectF bounds = this->items.at(i)->boundingRect();
+        this->itemBounds.append(bounds);
+        this->allItemsBounds |= bounds;
+
+        const QRect cells = getIndexCells(bounds);
+        if (static_cast<qint64>(cells.width()) * cells.height() > maxIndexedCells) {
+            this->unindexedItems.append(i);
+            continue;
+        }
+        for (int y = cells.top(); y <= cells.bottom(); y++)
+        for (int x = cells.left(); x <= cells.right(); x++)
+            this->itemIndex[getIndexKey(x, y)].append(i);
+    }
+    this->itemIndexValid = true;
+}
+
+// Returns the indexes of the items that intersect the given rect, in the order they were added.
+QVector<int> Overlay::getItemsInRect(const QRectF &rect) {
+    QVector<int> candidates;
+    const QRect cells = getIndexCells(rect.intersected(this->allItemsBounds));
+    if (static_cast<qint64>(cells.width()) * cells.height() >= this->items.length()) {
+        candidates.reserve(this->items.length());
+        for (int i = 0; i < this->items.length(); i++)
+            candidates.append(i);
+    } else {
+        candidates = this->unindexedItems;
+        for (int y = cells.top(); y <= cells.bottom(); y++)
+        for (int x = cells.left(); x <= cells.right(); x++)
+            candidates.append(this->itemIndex.value(getIndexKey(x, y)));
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    QVector<int> indexes;
+    for (int i : candidates) {
+        if (this->itemBounds.at(i).intersects(rect))
+            indexes.append(i);
+    }
+    return indexes;
+}
+
+// Called whenever the overlay's items change, or anything else that's baked into the cached image.
+void Overlay::invalidateItems() {
+    this->itemIndexValid = false;
+    this->cacheValid = false;
+    this->cache = QPixmap();
+    this->unchangedRenders = 0;
+}
+
+void Overlay::addItem(OverlayItem *item) {
+    item->setFont(this->font);
+    this->items.append(item);
+    this->invalidateItems();
 }
 
 void Overlay::clearItems() {
@@ -48,6 +195,7 @@ void Overlay::clearItems() {
         delete item;
     }
     this->items.clear();
+    this->invalidateItems();
 }
 
 QList<OverlayItem*> Overlay::getItems() {
@@ -72,6 +220,7 @@ void Overlay::setOpacity(int opacity) {
         return;
     }
     this->opacity = static_cast<qreal>(opacity) / 100;
+    this->invalidateItems();
 }
 
 int Overlay::getX() {
@@ -169,7 +318,7 @@ QColor Overlay::getColor(QString colorStr) {
 }
 
 void Overlay::addText(const QString text, int x, int y, QString colorStr, int fontSize) {
-    this->items.append(new OverlayText(text, x, y, getColor(colorStr), fontSize));
+    this->addItem(new OverlayText(text, x, y, getColor(colorStr), fontSize));
 }
 
 bool Overlay::addRect(int x, int y, int width, int height, QString borderColorStr, QString fillColorStr, int rounding) {
@@ -180,7 +329,7 @@ bool Overlay::addRect(int x, int y, int width, int height, QString borderColorSt
 
     QPainterPath path;
     path.addRoundedRect(QRectF(x, y, width, height), rounding, rounding, Qt::RelativeSize);
-    this->items.append(new OverlayPath(path, getColor(borderColorStr), getColor(fillColorStr)));
+    this->addItem(new OverlayPath(path, getColor(borderColorStr), getColor(fillColorStr)));
     return true;
 }
 
@@ -197,7 +346,7 @@ bool Overlay::addPath(QList<int> xCoords, QList<int> yCoords, QString borderColo
     for (int i = 1; i < numPoints; i++)
         path.lineTo(xCoords.at(i), yCoords.at(i));
 
-    this->items.append(new OverlayPath(path, getColor(borderColorStr), getColor(fillColorStr)));
+    this->addItem(new OverlayPath(path, getColor(borderColorStr), getColor(fillColorStr)));
     return true;
 }
 
@@ -244,7 +393,7 @@ bool Overlay::addImage(int x, int y, QString filepath, bool useCache, int width,
     if (setTransparency)
         image.setColor(0, qRgba(0, 0, 0, 0));
 
-    this->items.append(new OverlayImage(x, y, image));
+    this->addItem(new OverlayImage(x, y, image));
     return true;
 }
 
@@ -253,6 +402,6 @@ bool Overlay::addImage(int x, int y, QImage image) {
         logError(QString("Failed to load custom image"));
         return false;
     }
-    this->items.append(new OverlayImage(x, y, image));
+    this->addItem(new OverlayImage(x, y, image));
     return true;
 }
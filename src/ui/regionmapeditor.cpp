@@ -396,17 +396,13 @@ poryjson::Json RegionMapEditor::configRegionMapDialog() {
     return poryjson::Json();
 }
 
-bool RegionMapEditor::verifyConfig(poryjson::Json cfg) {
-    OrderedJson::object obj = cfg.object_items();
-
-    if (!obj.contains("region_maps")) {
+bool RegionMapEditor::verifyConfig(const poryjson::Json &cfg) {
+    if (!cfg.has_key("region_maps")) {
         logError("Region map config json has no map list.");
         return false;
     }
 
-    OrderedJson::array arr = obj["region_maps"].array_items();
-
-    for (auto ref : arr) {
+    for (const OrderedJson &ref : cfg["region_maps"].array_items()) {
         RegionMap tempMap(this->project);
         if (!tempMap.loadMapData(ref)) {
             return false;
@@ -467,9 +463,8 @@ bool RegionMapEditor::setup() {
     loadRegionMapEntries();
 
     // load the region maps into this->region_maps
-    poryjson::Json::object regionMapObjectCopy = this->rmConfigJson.object_items();
-    for (auto o : regionMapObjectCopy["region_maps"].array_items()) {
-        QString alias = o.object_items().at("alias").string_value();
+    for (const OrderedJson &o : this->rmConfigJson["region_maps"].array_items()) {
+        QString alias = o["alias"].string_value();
 
         RegionMap *newMap = new RegionMap(this->project);
         newMap->setEntries(&this->region_map_entries);
@@ -510,9 +505,9 @@ bool RegionMapEditor::load(bool silent) {
     if (QFile::exists(jsonConfigFilepath)) {
         logInfo("Region map configuration file found.");
         ParseUtil parser;
-        OrderedJson::object obj;
-        if (parser.tryParseOrderedJsonFile(&obj, jsonConfigFilepath)) {
-            this->rmConfigJson = OrderedJson(obj);
+        OrderedJson configJson;
+        if (parser.tryParseOrderedJsonFile(&configJson, jsonConfigFilepath)) {
+            this->rmConfigJson = std::move(configJson);
             this->configSaved = true;
         }
         badConfig = !verifyConfig(this->rmConfigJson);
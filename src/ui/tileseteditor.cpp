@@ -114,9 +114,11 @@ void TilesetEditor::initUi() {
 void TilesetEditor::setAttributesUi() {
     // Behavior
     if (projectConfig.getMetatileBehaviorMask()) {
-        for (int num : project->metatileBehaviorMapInverse.keys()) {
-            this->ui->comboBox_metatileBehaviors->addItem(project->metatileBehaviorMapInverse[num], num);
-        }
+        QVariantList behaviorValues;
+        for (int num : project->metatileBehaviorMapInverse.keys())
+            behaviorValues.append(num);
+        auto model = project->getListModel("metatileBehaviors", project->metatileBehaviorMapInverse.values(), behaviorValues);
+        this->ui->comboBox_metatileBehaviors->setSharedModel(model);
         this->ui->comboBox_metatileBehaviors->setMinimumContentsLength(0);
     } else {
         this->ui->comboBox_metatileBehaviors->setVisible(false);
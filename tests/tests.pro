@@ -0,0 +1,23 @@
+#-------------------------------------------------
+#
+# Unit tests for porymap's core code.
+# Build and run with: qmake && make check
+#
+#-------------------------------------------------
+
+QT       += core testlib
+QT       -= gui
+
+TARGET = porymap-tests
+TEMPLATE = app
+CONFIG += console testcase
+CONFIG -= app_bundle
+QMAKE_CXXFLAGS += -std=c++17 -Wall
+
+INCLUDEPATH += ../include/lib
+
+SOURCES += tst_orderedjson.cpp \
+    ../src/lib/orderedjson.cpp
+
+HEADERS += ../include/lib/orderedjson.h \
+    ../include/lib/orderedmap.h
@@ -0,0 +1,77 @@
+#include "orderedjson.h"
+
+#include <QBuffer>
+#include <QtTest>
+
+using poryjson::Json;
+
+class TestOrderedJson : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesObjectsInOrder();
+    void parsesUtf8Strings();
+    void skipsByteOrderMark();
+    void rejectsTrailingGarbage();
+    void dumpsParsedDocument();
+};
+
+void TestOrderedJson::parsesObjectsInOrder() {
+    QString err;
+    const Json json = Json::parse(QByteArray(R"({"b": 1, "a": [true, null, "x"], "c": -2.5})"), err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QVERIFY(json.is_object());
+
+    QStringList keys;
+    for (const auto &item : json.object_items())
+        keys.append(item.first);
+    QCOMPARE(keys, QStringList({"b", "a", "c"}));
+    QCOMPARE(json["b"].int_value(), 1);
+    QCOMPARE(static_cast<int>(json["a"].array_items().size()), 3);
+    QCOMPARE(json["a"][2].string_value(), QString("x"));
+    QCOMPARE(json["c"].number_value(), -2.5);
+}
+
+void TestOrderedJson::parsesUtf8Strings() {
+    QString err;
+    const Json json = Json::parse(QString(R"({"name": "Pokémon é"})").toUtf8(), err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QCOMPARE(json["name"].string_value(), QString("Pokémon é"));
+}
+
+void TestOrderedJson::skipsByteOrderMark() {
+    QString err;
+    const Json json = Json::parse(QByteArray("\xEF\xBB\xBF{\"key\": \"value\"}"), err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QCOMPARE(json["key"].string_value(), QString("value"));
+
+    // A byte order mark is only allowed at the start of the input.
+    Json::parse(QByteArray("{\"key\": \"value\"}\xEF\xBB\xBF"), err);
+    QVERIFY(!err.isEmpty());
+}
+
+void TestOrderedJson::rejectsTrailingGarbage() {
+    QString err;
+    const Json json = Json::parse(QByteArray("[1, 2] 3"), err);
+    QVERIFY(!err.isEmpty());
+    QVERIFY(json.is_null());
+}
+
+void TestOrderedJson::dumpsParsedDocument() {
+    const QByteArray input = R"({"b": [1, 2], "a": {"c": "é"}})";
+    QString err;
+    const Json json = Json::parse(input, err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    json.dump(&buffer);
+    const Json reparsed = Json::parse(buffer.data(), err);
+    QVERIFY2(err.isEmpty(), qPrintable(err));
+    QVERIFY(reparsed == json);
+    QCOMPARE(QString::fromUtf8(buffer.data()), json.dump());
+}
+
+QTEST_APPLESS_MAIN(TestOrderedJson)
+#include "tst_orderedjson.moc"